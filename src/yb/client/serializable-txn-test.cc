@@ -24,6 +24,7 @@
 
 using namespace std::literals;
 
+DECLARE_int32(transaction_conflict_wait_timeout_ms);
 DECLARE_int64(transaction_rpc_timeout_ms);
 DECLARE_int32(txn_max_apply_batch_records);
 
@@ -133,6 +134,45 @@ TEST_F(SerializableTxnTest, ReadWriteConflict) {
   ASSERT_GE(writes_won, kKeys / 4);
 }
 
+// Same as ReadWriteConflict, but write transaction waits for read transaction of higher priority
+// to commit, instead of failing.
+TEST_F(SerializableTxnTest, ReadWriteConflictWait) {
+  FLAGS_transaction_conflict_wait_timeout_ms = 30000;
+  const auto kKeys = 20;
+
+  size_t both_committed = 0;
+  for (int i = 0; i != kKeys; ++i) {
+    auto read_txn = CreateTransaction();
+    auto read_session = CreateSession(read_txn);
+    auto read = ReadRow(read_session, i);
+    ASSERT_OK(read_session->Flush());
+
+    auto write_txn = CreateTransaction();
+    auto write_session = CreateSession(write_txn);
+    ASSERT_RESULT(WriteRow(write_session, i, i, WriteOpType::INSERT, Flush::kFalse));
+    auto write_flush_future = write_session->FlushFuture();
+    // Give write a chance to detect the conflict before read is committed.
+    std::this_thread::sleep_for(100ms);
+
+    auto read_status = read_txn->CommitFuture().get();
+    auto write_status = write_flush_future.get();
+    if (write_status.ok()) {
+      write_status = write_txn->CommitFuture().get();
+    }
+
+    LOG(INFO) << "Read: " << read_status << ", write: " << write_status;
+
+    // Write either aborts read or waits for it, so it should always succeed.
+    ASSERT_OK(write_status);
+    if (read_status.ok()) {
+      ++both_committed;
+    }
+  }
+
+  LOG(INFO) << "Both committed: " << both_committed;
+  ASSERT_GE(both_committed, kKeys / 4);
+}
+
 // Execute UPDATE table SET value = value + 1 WHERE key = kKey in parallel, using
 // serializable isolation.
 // With retries the resulting value should be equal to number of increments.
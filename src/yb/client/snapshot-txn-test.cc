@@ -43,6 +43,8 @@ DECLARE_int32(TEST_inject_load_transaction_delay_ms);
 DECLARE_int32(TEST_inject_status_resolver_delay_ms);
 DECLARE_int32(log_min_seconds_to_retain);
 DECLARE_int32(txn_max_apply_batch_records);
+DECLARE_int32(txn_apply_intents_min_part_records);
+DECLARE_int32(apply_intents_pool_max_threads);
 DECLARE_uint64(max_transactions_in_status_request);
 DECLARE_bool(TEST_disallow_lmp_failures);
 
@@ -737,6 +739,15 @@ TEST_F(SnapshotTxnTest, MultiWriteWithRestartAndLongApply) {
   TestMultiWriteWithRestart();
 }
 
+TEST_F(SnapshotTxnTest, MultiWriteWithRestartAndParallelApply) {
+  FLAGS_txn_max_apply_batch_records = 9;
+  FLAGS_txn_apply_intents_min_part_records = 1;
+  FLAGS_apply_intents_pool_max_threads = 4;
+  // Restart cluster, so tablet servers create apply intents thread pool.
+  ASSERT_OK(cluster_->RestartSync());
+  TestMultiWriteWithRestart();
+}
+
 using RemoteBootstrapOnStartBase = TransactionCustomLogSegmentSizeTest<128, SnapshotTxnTest>;
 
 void SnapshotTxnTest::TestRemoteBootstrap() {
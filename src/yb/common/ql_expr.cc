@@ -561,12 +561,12 @@ CHECKED_STATUS QLExprExecutor::EvalCondition(const PgsqlConditionPB& condition,
     case QL_OP_IN:
       CHECK_EQ(operands.size(), 2);
       result->set_bool_value(VERIFY_RESULT(In(this, operands, table_row)));
-      break;
+      return Status::OK();
 
     case QL_OP_NOT_IN:
       CHECK_EQ(operands.size(), 2);
       result->set_bool_value(!VERIFY_RESULT(In(this, operands, table_row)));
-      break;
+      return Status::OK();
 
     case QL_OP_LIKE: FALLTHROUGH_INTENDED;
     case QL_OP_NOT_LIKE:
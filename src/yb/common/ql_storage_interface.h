@@ -100,6 +100,17 @@ class YQLStorageIf {
                                      const ReadHybridTime& read_time,
                                      const QLValuePB& ybctid,
                                      common::YQLRowwiseIteratorIf::UniPtr* iter) const = 0;
+
+  // Create iterator for looking up a batch of rows by ybctid with SeekTuple. All lookups of the
+  // batch share the same iterator, so they should be done in ascending ybctid order.
+  // The iterator does not use bloom filters, since lookups are not limited to a single key.
+  virtual CHECKED_STATUS GetIterator(uint64 stmt_id,
+                                     const Schema& projection,
+                                     const Schema& schema,
+                                     const TransactionOperationContextOpt& txn_op_context,
+                                     CoarseTimePoint deadline,
+                                     const ReadHybridTime& read_time,
+                                     common::YQLRowwiseIteratorIf::UniPtr* iter) const = 0;
 };
 
 }  // namespace common
@@ -16,6 +16,10 @@
 #ifndef YB_COMMON_TRANSACTION_TEST_UTIL_H
 #define YB_COMMON_TRANSACTION_TEST_UTIL_H
 
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "yb/common/hybrid_time.h"
@@ -26,6 +30,12 @@ namespace yb {
 
 class TransactionStatusManagerMock : public TransactionStatusManager {
  public:
+  ~TransactionStatusManagerMock() {
+    for (auto& thread : waiter_threads_) {
+      thread.join();
+    }
+  }
+
   HybridTime LocalCommitTime(const TransactionId &id) override {
     return HybridTime::kInvalid;
   }
@@ -61,8 +71,18 @@ class TransactionStatusManagerMock : public TransactionStatusManager {
     return HybridTime::kMin;
   }
 
+  void WaitForTransaction(
+      const TransactionId& id, CoarseTimePoint deadline,
+      std::function<void(const Status&)> callback) override {
+    // Real status manager never invokes callback from WaitForTransaction itself.
+    std::lock_guard<std::mutex> lock(waiter_threads_mutex_);
+    waiter_threads_.emplace_back(std::move(callback), Status::OK());
+  }
+
  private:
   std::unordered_map<TransactionId, HybridTime, TransactionIdHash> txn_commit_time_;
+  std::mutex waiter_threads_mutex_;
+  std::vector<std::thread> waiter_threads_;
 };
 
 } // namespace yb
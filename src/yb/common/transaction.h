@@ -139,6 +139,14 @@ class TransactionStatusManager {
   // Returns minimal running hybrid time of all running transactions.
   virtual HybridTime MinRunningHybridTime() const = 0;
 
+  // Invokes callback when specified transaction is not running on this tablet anymore, i.e. it
+  // was applied or aborted and cleaned up, or when deadline is reached, whichever comes first.
+  // Callback is invoked exactly once, asynchronously, on a thread where it is allowed to block.
+  // Failure status is passed to callback when waiting was aborted, for instance by shutdown.
+  virtual void WaitForTransaction(
+      const TransactionId& id, CoarseTimePoint deadline,
+      std::function<void(const Status&)> callback) = 0;
+
  private:
   friend class RequestScope;
 
@@ -26,8 +26,10 @@
 #include "yb/docdb/docdb.pb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/intent.h"
+#include "yb/docdb/lock_batch.h"
 #include "yb/docdb/shared_lock_manager.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/yb_pg_errcodes.h"
@@ -35,6 +37,14 @@
 using namespace std::literals;
 using namespace std::placeholders;
 
+DEFINE_int32(transaction_conflict_wait_timeout_ms, 0,
+             "When positive, transaction that conflicts with running transactions of higher "
+             "priority waits for them to finish up to this timeout, instead of failing "
+             "immediately. After timeout conflict is resolved by priority as usual, which also "
+             "breaks deadlocks between waiting transactions.");
+TAG_FLAG(transaction_conflict_wait_timeout_ms, runtime);
+TAG_FLAG(transaction_conflict_wait_timeout_ms, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -92,6 +102,16 @@ class ConflictResolverContext {
 
   virtual bool IgnoreConflictsWith(const TransactionId& other) = 0;
 
+  // Time until conflicting transactions of higher priority could be waited for,
+  // see FLAGS_transaction_conflict_wait_timeout_ms. Default value when waiting is not allowed.
+  virtual CoarseTimePoint WaitDeadline() = 0;
+
+  // Releases locks held by the resolved operations while waiting for conflicting transactions.
+  virtual void UnlockForWait() = 0;
+
+  // Acquires locks released by UnlockForWait again.
+  virtual CHECKED_STATUS RelockAfterWait() = 0;
+
   virtual std::string ToString() const = 0;
 
   virtual ~ConflictResolverContext() = default;
@@ -106,7 +126,7 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
                    ResolutionCallback callback)
       : doc_db_(doc_db), status_manager_(*status_manager), request_scope_(status_manager),
         partial_range_key_intents_(partial_range_key_intents), context_(std::move(context)),
-        callback_(std::move(callback)) {}
+        callback_(std::move(callback)), wait_deadline_(context_->WaitDeadline()) {}
 
   PartialRangeKeyIntents partial_range_key_intents() {
     return partial_range_key_intents_;
@@ -273,12 +293,66 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
       return true;
     }
 
-    RETURN_NOT_OK(context_->CheckPriority(this, &transactions_));
+    auto status = context_->CheckPriority(this, &transactions_);
+    if (!status.ok()) {
+      if (CoarseMonoClock::now() < wait_deadline_) {
+        WaitForTransactions();
+        return false;
+      }
+      return status;
+    }
 
     AbortTransactions();
     return false;
   }
 
+  // Waits until any of conflicting transactions finishes or wait deadline is reached, then
+  // repeats resolution.
+  // Our locks are released while waiting, so the conflicting transactions could make progress
+  // and other operations are not blocked on them. Since new conflicting intents could be written
+  // meanwhile, conflicts are read again after the locks are reacquired.
+  void WaitForTransactions() {
+    VLOG_WITH_PREFIX(4) << "Wait for: " << yb::ToString(transactions_);
+    auto self = shared_from_this();
+    std::vector<TransactionId> ids;
+    ids.reserve(transactions_.size());
+    for (const auto& transaction : transactions_) {
+      ids.push_back(transaction.id);
+    }
+    intent_iter_.Reset();
+    context_->UnlockForWait();
+    waiting_.store(true, std::memory_order_release);
+    for (const auto& id : ids) {
+      status_manager().WaitForTransaction(id, wait_deadline_, [self](const Status& status) {
+        bool expected = true;
+        if (self->waiting_.compare_exchange_strong(expected, false, std::memory_order_acq_rel)) {
+          self->WaitForTransactionsDone(status);
+        }
+      });
+    }
+  }
+
+  // Invoked on a thread pool thread, so it is ok to block while acquiring locks.
+  void WaitForTransactionsDone(const Status& wait_status) {
+    if (!wait_status.ok()) {
+      VLOG_WITH_PREFIX(4) << "Wait failed: " << wait_status;
+      InvokeCallback(wait_status.IsAborted()
+          ? wait_status
+          : STATUS_FORMAT(Aborted, "Wait for conflicting transactions failed: $0", wait_status));
+      return;
+    }
+
+    auto status = context_->RelockAfterWait();
+    if (!status.ok()) {
+      InvokeCallback(status);
+      return;
+    }
+
+    conflicts_.clear();
+    transactions_.clear();
+    Resolve();
+  }
+
   Result<bool> CheckLocalCommits() {
     auto write_iterator = transactions_.begin();
     for (const auto& transaction : transactions_) {
@@ -422,6 +496,10 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
   TransactionIdSet conflicts_;
   std::vector<TransactionData> transactions_;
   std::atomic<int> pending_requests_{0};
+
+  // Conflicting transactions of higher priority are waited for until this time.
+  const CoarseTimePoint wait_deadline_;
+  std::atomic<bool> waiting_{false};
 };
 
 struct IntentData {
@@ -657,11 +735,15 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
                                      const KeyValueWriteBatchPB& write_batch,
                                      HybridTime resolution_ht,
                                      HybridTime read_time,
-                                     Counter* conflicts_metric)
+                                     Counter* conflicts_metric,
+                                     LockBatch* lock_batch,
+                                     CoarseTimePoint deadline)
       : ConflictResolverContextBase(doc_ops, resolution_ht, conflicts_metric),
         write_batch_(write_batch),
         read_time_(read_time),
-        transaction_id_(FullyDecodeTransactionId(write_batch.transaction().transaction_id()))
+        transaction_id_(FullyDecodeTransactionId(write_batch.transaction().transaction_id())),
+        lock_batch_(lock_batch),
+        deadline_(deadline)
   {}
 
   virtual ~TransactionConflictResolverContext() {}
@@ -783,6 +865,24 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
     return other == *transaction_id_;
   }
 
+  CoarseTimePoint WaitDeadline() override {
+    auto wait_timeout_ms = FLAGS_transaction_conflict_wait_timeout_ms;
+    if (wait_timeout_ms <= 0) {
+      return CoarseTimePoint();
+    }
+    return std::min<CoarseTimePoint>(deadline_, CoarseMonoClock::now() + wait_timeout_ms * 1ms);
+  }
+
+  void UnlockForWait() override {
+    if (lock_batch_) {
+      lock_batch_->Unlock();
+    }
+  }
+
+  CHECKED_STATUS RelockAfterWait() override {
+    return lock_batch_ ? lock_batch_->Relock(deadline_) : Status::OK();
+  }
+
   std::string ToString() const override {
     return yb::ToString(transaction_id_);
   }
@@ -798,6 +898,12 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
 
   TransactionMetadata metadata_;
 
+  // Locks held for write_batch_, could be null.
+  LockBatch* const lock_batch_;
+
+  // Deadline of the operation, used to limit waiting and to reacquire locks.
+  const CoarseTimePoint deadline_;
+
   Status result_ = Status::OK();
 };
 
@@ -859,6 +965,17 @@ class OperationConflictResolverContext : public ConflictResolverContextBase {
     return false;
   }
 
+  CoarseTimePoint WaitDeadline() override {
+    return CoarseTimePoint();
+  }
+
+  void UnlockForWait() override {
+  }
+
+  CHECKED_STATUS RelockAfterWait() override {
+    return Status::OK();
+  }
+
   std::string ToString() const override {
     return "Operation Context";
   }
@@ -883,10 +1000,12 @@ void ResolveTransactionConflicts(const DocOperations& doc_ops,
                                  PartialRangeKeyIntents partial_range_key_intents,
                                  TransactionStatusManager* status_manager,
                                  Counter* conflicts_metric,
+                                 LockBatch* lock_batch,
+                                 CoarseTimePoint deadline,
                                  ResolutionCallback callback) {
   DCHECK(hybrid_time.is_valid());
   auto context = std::make_unique<TransactionConflictResolverContext>(
-      doc_ops, write_batch, hybrid_time, read_time, conflicts_metric);
+      doc_ops, write_batch, hybrid_time, read_time, conflicts_metric, lock_batch, deadline);
   auto resolver = std::make_shared<ConflictResolver>(
       doc_db, status_manager, partial_range_key_intents, std::move(context), std::move(callback));
   // Resolve takes a self reference to extend lifetime.
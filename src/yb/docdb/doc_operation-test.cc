@@ -28,15 +28,20 @@
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/doc_ql_scanspec.h"
+#include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/ql_rocksdb_storage.h"
 #include "yb/docdb/redis_operation.h"
 
 #include "yb/server/hybrid_clock.h"
 
+#include "yb/util/bfpg/tserver_opcodes.h"
 #include "yb/util/random_util.h"
 #include "yb/util/size_literals.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/tostring.h"
 
+#include "yb/yql/pggate/util/pg_doc_data.h"
+
 DECLARE_uint64(rocksdb_max_file_size_for_compaction);
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
@@ -238,6 +243,82 @@ SubDocKey(DocKey(0x0000, [1], []), [ColumnId(3); HT{ <max> w: 2 }]) -> 4
     EXPECT_OK(row_block.Deserialize(YQL_CLIENT_CQL, &data));
     return row_block;
   }
+
+  // Inserts rows (key, key, key * 10, key * 100) for keys in [1, num_rows].
+  void WriteRows(const Schema& schema, int32_t num_rows) {
+    for (int32_t key = 1; key <= num_rows; ++key) {
+      WriteQLRow(QLWriteRequestPB_QLStmtType_QL_STMT_INSERT, schema,
+                 vector<int32_t>({key, key, key * 10, key * 100}), 1000,
+                 HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(1000, key));
+    }
+  }
+
+  // Executes YSQL read request over rows of kFixedHashCode, returns the number of fetched rows.
+  size_t ReadPgsqlRows(const Schema& schema, PgsqlReadRequestPB* request,
+                       faststring* result_buffer,
+                       PgsqlParallelScan parallel_scan = PgsqlParallelScan()) {
+    request->set_hash_code(kFixedHashCode);
+    request->set_max_hash_code(kFixedHashCode);
+    PgsqlReadOperation read_op(*request, kNonTransactionalOperationContext);
+    read_op.SetParallelScan(std::move(parallel_scan));
+    QLRocksDBStorage ql_storage(doc_db());
+    HybridTime read_restart_ht;
+    auto result = read_op.Execute(
+        ql_storage, CoarseTimePoint::max() /* deadline */,
+        ReadHybridTime::SingleTime(HybridClock::HybridTimeFromMicrosecondsAndLogicalValue(2000, 0)),
+        false /* is_explicit_request_read_time */, schema, nullptr /* index_schema */,
+        result_buffer, &read_restart_ht);
+    EXPECT_OK(result);
+    EXPECT_FALSE(read_restart_ht.is_valid());
+    EXPECT_FALSE(read_op.response().has_paging_state());
+    return result.ok() ? *result : 0;
+  }
+
+  // Inserts rows (key, key, key * 10, key * 100) for keys in [1, num_rows] and reads
+  // SELECT COUNT(c2), SUM(c3) from them.
+  // Returns partial aggregates (count, sum) of each fetched row.
+  std::vector<std::pair<int64_t, int64_t>> ReadAggregates(
+      int32_t num_rows, PgsqlParallelScan parallel_scan = PgsqlParallelScan()) {
+    Schema schema = CreateSchema();
+    WriteRows(schema, num_rows);
+
+    PgsqlReadRequestPB request;
+    request.set_is_aggregate(true);
+    // Aggregate requests are not limited by the row count.
+    request.set_limit(1);
+    request.set_return_paging_state(true);
+    auto* tscall = request.add_targets()->mutable_tscall();
+    tscall->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kCount));
+    tscall->add_operands()->set_column_id(2);
+    tscall = request.add_targets()->mutable_tscall();
+    tscall->set_opcode(static_cast<int32_t>(bfpg::TSOpcode::kSumInt32));
+    tscall->add_operands()->set_column_id(3);
+    for (int32_t column_id = 2; column_id <= 3; ++column_id) {
+      request.mutable_column_refs()->add_ids(column_id);
+    }
+
+    faststring result_buffer;
+    auto fetched_rows = ReadPgsqlRows(
+        schema, &request, &result_buffer, std::move(parallel_scan));
+
+    Slice cursor(result_buffer.data(), result_buffer.size());
+    int64_t row_count = 0;
+    cursor.remove_prefix(pggate::PgWire::ReadNumber(&cursor, &row_count));
+    EXPECT_EQ(static_cast<int64_t>(fetched_rows), row_count);
+    auto read_int64 = [&cursor] {
+      EXPECT_FALSE(pggate::PgDocData::ReadDataHeader(&cursor).is_null());
+      int64_t value = 0;
+      cursor.remove_prefix(pggate::PgWire::ReadNumber(&cursor, &value));
+      return value;
+    };
+    std::vector<std::pair<int64_t, int64_t>> result;
+    for (size_t i = 0; i != fetched_rows; ++i) {
+      auto count = read_int64();
+      result.emplace_back(count, read_int64());
+    }
+    EXPECT_TRUE(cursor.empty());
+    return result;
+  }
 };
 
 TEST_F(DocOperationTest, TestRedisSetKVWithTTL) {
@@ -373,6 +454,84 @@ SubDocKey(DocKey(0x0000, [100], []), [ColumnId(3); HT{ physical: 0 logical: 3000
   EXPECT_EQ(4, row_block.row(0).column(3).int32_value());
 }
 
+TEST_F(DocOperationTest, PgsqlReadConditionExpr) {
+  Schema schema = CreateSchema();
+  WriteRows(schema, 10);
+
+  // c2 > 50 AND c3 IN (700, 900, 1100)
+  PgsqlReadRequestPB request;
+  request.add_targets()->set_column_id(1);
+  request.mutable_column_refs()->add_ids(1);
+  request.mutable_column_refs()->add_ids(2);
+  request.mutable_column_refs()->add_ids(3);
+  auto* and_condition = request.mutable_condition_expr()->mutable_condition();
+  and_condition->set_op(QL_OP_AND);
+  auto* condition = and_condition->add_operands()->mutable_condition();
+  condition->set_op(QL_OP_GREATER_THAN);
+  condition->add_operands()->set_column_id(2);
+  condition->add_operands()->mutable_value()->set_int32_value(50);
+  condition = and_condition->add_operands()->mutable_condition();
+  condition->set_op(QL_OP_IN);
+  condition->add_operands()->set_column_id(3);
+  auto* list = condition->add_operands()->mutable_value()->mutable_list_value();
+  for (int32_t value : {700, 900, 1100}) {
+    list->add_elems()->set_int32_value(value);
+  }
+
+  // Scan bounds are built for key columns only, so rows are filtered by the compiled condition.
+  faststring result_buffer;
+  ASSERT_EQ(2, ReadPgsqlRows(schema, &request, &result_buffer));
+}
+
+TEST_F(DocOperationTest, PgsqlReadConditionExprNotCompiled) {
+  Schema schema = CreateSchema();
+  WriteRows(schema, 10);
+
+  // c2 = 30 OR c3 IN (900, 1000)
+  PgsqlReadRequestPB request;
+  request.add_targets()->set_column_id(1);
+  request.mutable_column_refs()->add_ids(1);
+  request.mutable_column_refs()->add_ids(2);
+  request.mutable_column_refs()->add_ids(3);
+  auto* or_condition = request.mutable_condition_expr()->mutable_condition();
+  or_condition->set_op(QL_OP_OR);
+  auto* condition = or_condition->add_operands()->mutable_condition();
+  condition->set_op(QL_OP_EQUAL);
+  condition->add_operands()->set_column_id(2);
+  condition->add_operands()->mutable_value()->set_int32_value(30);
+  condition = or_condition->add_operands()->mutable_condition();
+  condition->set_op(QL_OP_IN);
+  condition->add_operands()->set_column_id(3);
+  auto* list = condition->add_operands()->mutable_value()->mutable_list_value();
+  for (int32_t value : {900, 1000}) {
+    list->add_elems()->set_int32_value(value);
+  }
+
+  // Only conjunctions are compiled, so rows are filtered by the expression executor.
+  faststring result_buffer;
+  ASSERT_EQ(3, ReadPgsqlRows(schema, &request, &result_buffer));
+}
+
+TEST_F(DocOperationTest, PgsqlAggregateParallelScan) {
+  std::unique_ptr<ThreadPool> pool;
+  ASSERT_OK(ThreadPoolBuilder("parallel-scan").set_max_threads(2).Build(&pool));
+  // Key ranges [1, 3], [4, 7] and [8, 10] contain rows, the first key range is empty.
+  PgsqlParallelScan parallel_scan;
+  parallel_scan.pool = pool.get();
+  for (int32_t key : {0, 4, 8}) {
+    parallel_scan.split_keys.push_back(
+        DocKey(kFixedHashCode, PrimitiveValues(PrimitiveValue::Int32(key)), PrimitiveValues())
+            .Encode().ToStringBuffer());
+  }
+
+  // Each non empty key range is aggregated separately and returned in key order.
+  auto aggregates = ReadAggregates(10, parallel_scan);
+  const std::vector<std::pair<int64_t, int64_t>> expected_aggregates = {
+      {3, 600}, {4, 2200}, {3, 2700}};
+  ASSERT_EQ(expected_aggregates, aggregates);
+  pool->Shutdown();
+}
+
 TEST_F(DocOperationTest, TestQLReadWithTombstone) {
   DocKey doc_key(0, PrimitiveValues(PrimitiveValue::Int32(100)), PrimitiveValues());
   KeyBytes encoded_doc_key(doc_key.Encode());
@@ -20,6 +20,15 @@
 #include "yb/docdb/doc_scanspec_util.h"
 #include "yb/rocksdb/db/compaction.h"
 
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(pgsql_enable_range_skip_scan, true,
+            "Use skip scan for YSQL reads that have IN/EQ conditions on some range columns, but "
+            "not on the leading ones. Such scans seek over distinct values of the unconstrained "
+            "range columns instead of scanning all of them.");
+TAG_FLAG(pgsql_enable_range_skip_scan, advanced);
+TAG_FLAG(pgsql_enable_range_skip_scan, runtime);
+
 namespace yb {
 namespace docdb {
 
@@ -138,8 +147,12 @@ DocPgsqlScanSpec::DocPgsqlScanSpec(const Schema& schema,
     InitRangeOptions(*condition);
 
     // Range options are only valid if all range columns are set (i.e. have one or more options).
+    // The exception is a forward skip scan, where columns without options (except the last one)
+    // accept any value within their range bounds, and the scan seeks over their distinct values.
+    const bool allow_skip_scan =
+        FLAGS_pgsql_enable_range_skip_scan && is_forward_scan_ && !range_options_->back().empty();
     for (int i = 0; i < schema_.num_range_key_columns(); i++) {
-      if ((*range_options_)[i].empty()) {
+      if ((*range_options_)[i].empty() && !allow_skip_scan) {
         range_options_ = nullptr;
         break;
       }
@@ -94,6 +94,8 @@ class DocPgsqlScanSpec : public common::PgsqlScanSpec {
   void InitRangeOptions(const PgsqlConditionPB& condition);
 
   // The range value options if set. (possibly more than one due to IN conditions).
+  // Options of a range column could be empty only in case of a skip scan, which means that any
+  // value of this column within range_bounds_ is accepted.
   std::shared_ptr<std::vector<std::vector<PrimitiveValue>>> range_options_;
 
   // Schema of the columns to scan.
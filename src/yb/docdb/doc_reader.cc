@@ -361,6 +361,36 @@ Status FindLastWriteTime(
   return Status::OK();
 }
 
+// Returns hybrid time of the tombstone of the colocated table that doc_key belongs to, or
+// DocHybridTime::kMin if the table was not deleted.
+Result<DocHybridTime> FindTableTombstoneTime(
+    IntentAwareIterator* db_iter, const Slice& doc_key, Expiration* exp) {
+  // Only check for table tombstones if the table is colocated, as signified by the prefix of
+  // kPgTableOid.
+  // TODO: adjust when fixing issue #3551
+  if (doc_key.empty() || doc_key[0] != ValueTypeAsChar::kPgTableOid) {
+    return DocHybridTime::kMin;
+  }
+  // Seek to the ID level to look for a table tombstone.
+  DocKey empty_key;
+  RETURN_NOT_OK(empty_key.DecodeFrom(doc_key, DocKeyPart::kUpToId));
+  db_iter->Seek(empty_key);
+  DocHybridTime max_overwrite_ht(DocHybridTime::kMin);
+  Value doc_value = Value(PrimitiveValue(ValueType::kInvalid));
+  RETURN_NOT_OK(FindLastWriteTime(
+      db_iter,
+      empty_key.Encode(),
+      &max_overwrite_ht,
+      exp,
+      &doc_value));
+  if (doc_value.value_type() != ValueType::kTombstone) {
+    return DocHybridTime::kMin;
+  }
+  SCHECK_NE(max_overwrite_ht, DocHybridTime::kInvalid, Corruption,
+            "Invalid hybrid time for table tombstone");
+  return max_overwrite_ht;
+}
+
 }  // namespace
 
 yb::Status GetSubDocument(
@@ -376,6 +406,12 @@ yb::Status GetSubDocument(
   return GetSubDocument(iter.get(), data, nullptr /* projection */, SeekFwdSuffices::kFalse);
 }
 
+Result<DocHybridTime> GetTableTombstoneTime(
+    const Slice& root_doc_key, IntentAwareIterator* db_iter) {
+  Expiration exp;
+  return FindTableTombstoneTime(db_iter, root_doc_key, &exp);
+}
+
 yb::Status GetSubDocument(
     IntentAwareIterator *db_iter,
     const GetSubDocumentData& data,
@@ -412,33 +448,11 @@ yb::Status GetSubDocument(
   // supported for YSQL colocated tables.  Since iterators only ever pertain to one table, there is
   // no need to create a prefix scope here.
   if (data.table_tombstone_time && *data.table_tombstone_time == DocHybridTime::kInvalid) {
-    // Only check for table tombstones if the table is colocated, as signified by the prefix of
-    // kPgTableOid.
-    // TODO: adjust when fixing issue #3551
-    if (key_slice[0] == ValueTypeAsChar::kPgTableOid) {
-      // Seek to the ID level to look for a table tombstone.  Since this seek is expensive, cache
-      // the result in data.table_tombstone_time to avoid double seeking for the lifetime of the
-      // DocRowwiseIterator.
-      DocKey empty_key;
-      RETURN_NOT_OK(empty_key.DecodeFrom(key_slice, DocKeyPart::kUpToId));
-      db_iter->Seek(empty_key);
-      Value doc_value = Value(PrimitiveValue(ValueType::kInvalid));
-      RETURN_NOT_OK(FindLastWriteTime(
-          db_iter,
-          empty_key.Encode(),
-          &max_overwrite_ht,
-          &data.exp,
-          &doc_value));
-      if (doc_value.value_type() == ValueType::kTombstone) {
-        SCHECK_NE(max_overwrite_ht, DocHybridTime::kInvalid, Corruption,
-                  "Invalid hybrid time for table tombstone");
-        *data.table_tombstone_time = max_overwrite_ht;
-      } else {
-        *data.table_tombstone_time = DocHybridTime::kMin;
-      }
-    } else {
-      *data.table_tombstone_time = DocHybridTime::kMin;
-    }
+    // Since this seek is expensive, cache the result in data.table_tombstone_time to avoid double
+    // seeking for the lifetime of the DocRowwiseIterator.
+    *data.table_tombstone_time = VERIFY_RESULT(FindTableTombstoneTime(
+        db_iter, key_slice, &data.exp));
+    max_overwrite_ht = *data.table_tombstone_time;
   } else if (data.table_tombstone_time) {
     // Use the cached result.  Don't worry about exp as YSQL does not support TTL, yet.
     max_overwrite_ht = *data.table_tombstone_time;
@@ -32,6 +32,7 @@
 #include "yb/docdb/value.h"
 #include "yb/docdb/subdocument.h"
 
+#include "yb/util/result.h"
 #include "yb/util/status.h"
 #include "yb/util/strongly_typed_bool.h"
 
@@ -134,6 +135,11 @@ yb::Status GetSubDocument(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time = ReadHybridTime::Max());
 
+// Returns hybrid time of the tombstone of the colocated table that root_doc_key belongs to, or
+// DocHybridTime::kMin if the table was not deleted or is not colocated. Repositions db_iter.
+Result<DocHybridTime> GetTableTombstoneTime(
+    const Slice& root_doc_key, IntentAwareIterator* db_iter);
+
 }  // namespace docdb
 }  // namespace yb
 
@@ -34,6 +34,8 @@
 
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
+DECLARE_bool(docdb_skip_sst_files_by_table_tombstone);
+
 using std::string;
 
 namespace yb {
@@ -98,14 +100,15 @@ class DiscreteScanChoices : public ScanChoices {
     }
   }
 
-  DiscreteScanChoices(const DocPgsqlScanSpec& doc_spec, const KeyBytes& lower_doc_key,
-                      const KeyBytes& upper_doc_key)
+  DiscreteScanChoices(const Schema& schema, const DocPgsqlScanSpec& doc_spec,
+                      const KeyBytes& lower_doc_key, const KeyBytes& upper_doc_key)
       : ScanChoices(doc_spec.is_forward_scan()) {
     range_cols_scan_options_ = doc_spec.range_options();
     current_scan_target_idxs_.resize(range_cols_scan_options_->size());
     for (int i = 0; i < range_cols_scan_options_->size(); i++) {
       current_scan_target_idxs_[i] = range_cols_scan_options_->at(i).begin();
     }
+    InitSkipScanBounds(schema, doc_spec);
 
     // Initialize target doc key.
     if (is_forward_scan_) {
@@ -138,6 +141,17 @@ class DiscreteScanChoices : public ScanChoices {
   Result<bool> InitScanTargetRangeGroupIfNeeded();
 
  private:
+  // Range column without options is a skip scan column: any value of it within the range bounds
+  // is accepted, and we seek from one distinct value of it to the next one.
+  bool IsSkipScanColumn(size_t col_idx) const {
+    return (*range_cols_scan_options_)[col_idx].empty();
+  }
+
+  void InitSkipScanBounds(const Schema& schema, const DocPgsqlScanSpec& doc_spec);
+
+  // Appends the first acceptable value of the column to the key.
+  void AppendFirstOptionToKey(size_t col_idx, KeyBytes* key) const;
+
   // For (multi)key scans (e.g. selects with 'IN' condition on the range columns) we hold the
   // options for each range column as we iteratively seek to each target key.
   // e.g. for a query "h = 1 and r1 in (2,3) and r2 in (4,5) and r3 = 6":
@@ -149,14 +163,55 @@ class DiscreteScanChoices : public ScanChoices {
   //                             corresponding index (updated along with current_scan_target_idxs_).
   std::shared_ptr<std::vector<std::vector<PrimitiveValue>>> range_cols_scan_options_;
   mutable std::vector<std::vector<PrimitiveValue>::const_iterator> current_scan_target_idxs_;
+
+  // Range bounds of the skip scan columns, e.g. for a query "h = 1 and r2 in (4, 5)" on a table
+  // with range columns r1, r2 these are [kLowest, <unused>] and [kHighest, <unused>]. The target
+  // goes from [1][kLowest, 4] to [1][r1_value_1, 4], [1][r1_value_1, 5], [1][r1_value_1, kHighest]
+  // (seeks to the next distinct value of r1), [1][r1_value_2, 4] and so on.
+  std::vector<PrimitiveValue> skip_scan_lower_;
+  std::vector<PrimitiveValue> skip_scan_upper_;
 };
 
+void DiscreteScanChoices::InitSkipScanBounds(
+    const Schema& schema, const DocPgsqlScanSpec& doc_spec) {
+  const auto num_range_cols = range_cols_scan_options_->size();
+  skip_scan_lower_.resize(num_range_cols);
+  skip_scan_upper_.resize(num_range_cols);
+  for (size_t i = 0; i != num_range_cols; ++i) {
+    if (!IsSkipScanColumn(i)) {
+      continue;
+    }
+    DCHECK(is_forward_scan_) << "Skip scan is supported only for forward scans";
+    const auto idx = schema.num_hash_key_columns() + i;
+    if (doc_spec.range_bounds()) {
+      const auto col_sort_type = schema.column(idx).sorting_type();
+      const auto range = doc_spec.range_bounds()->RangeFor(schema.column_id(idx));
+      skip_scan_lower_[i] = GetQLRangeBoundAsPVal(range, col_sort_type, true /* lower_bound */);
+      skip_scan_upper_[i] = GetQLRangeBoundAsPVal(range, col_sort_type, false /* upper_bound */);
+    } else {
+      skip_scan_lower_[i] = PrimitiveValue(ValueType::kLowest);
+      skip_scan_upper_[i] = PrimitiveValue(ValueType::kHighest);
+    }
+  }
+}
+
+void DiscreteScanChoices::AppendFirstOptionToKey(size_t col_idx, KeyBytes* key) const {
+  if (IsSkipScanColumn(col_idx)) {
+    skip_scan_lower_[col_idx].AppendToKey(key);
+  } else {
+    current_scan_target_idxs_[col_idx]->AppendToKey(key);
+  }
+}
+
 Status DiscreteScanChoices::IncrementScanTargetAtColumn(size_t start_col) {
   DCHECK_LE(start_col, current_scan_target_idxs_.size());
 
   // Increment start col, move backwards in case of overflow.
   int col_idx = start_col;
   for (; col_idx >= 0; col_idx--) {
+    if (IsSkipScanColumn(col_idx)) {
+      break;
+    }
     const auto& choices = range_cols_scan_options_->at(col_idx);
     auto& it = current_scan_target_idxs_[col_idx];
 
@@ -178,6 +233,16 @@ Status DiscreteScanChoices::IncrementScanTargetAtColumn(size_t start_col) {
     RETURN_NOT_OK(decoder.DecodePrimitiveValue());
   }
 
+  if (IsSkipScanColumn(col_idx)) {
+    // Keep the current value of the skip scan column and go past all keys having it, so the next
+    // seek lands on the next distinct value of this column.
+    RETURN_NOT_OK(decoder.DecodePrimitiveValue());
+    current_scan_target_.Truncate(
+        decoder.left_input().cdata() - current_scan_target_.AsSlice().cdata());
+    PrimitiveValue(ValueType::kHighest).AppendToKey(&current_scan_target_);
+    return Status::OK();
+  }
+
   current_scan_target_.Truncate(
       decoder.left_input().cdata() - current_scan_target_.AsSlice().cdata());
 
@@ -196,7 +261,7 @@ Result<bool> DiscreteScanChoices::InitScanTargetRangeGroupIfNeeded() {
   if (!VERIFY_RESULT(decoder.HasPrimitiveValue())) {
     current_scan_target_.mutable_data()->pop_back();
     for (size_t col_idx = 0; col_idx < range_cols_scan_options_->size(); col_idx++) {
-      current_scan_target_idxs_[col_idx]->AppendToKey(&current_scan_target_);
+      AppendFirstOptionToKey(col_idx, &current_scan_target_);
     }
     current_scan_target_.AppendValueType(ValueType::kGroupEnd);
     return true;
@@ -228,6 +293,24 @@ Status DiscreteScanChoices::SkipTargetsUpTo(const Slice& new_target) {
   PrimitiveValue target_value;
   while (col_idx < range_cols_scan_options_->size()) {
     RETURN_NOT_OK(decoder.DecodePrimitiveValue(&target_value));
+
+    if (IsSkipScanColumn(col_idx)) {
+      if (target_value < skip_scan_lower_[col_idx]) {
+        skip_scan_lower_[col_idx].AppendToKey(&current_scan_target_);
+        col_idx++;
+        break;
+      }
+      if (target_value > skip_scan_upper_[col_idx]) {
+        // Go past all keys with the current values of the previous columns.
+        PrimitiveValue(ValueType::kHighest).AppendToKey(&current_scan_target_);
+        col_idx++;
+        break;
+      }
+      target_value.AppendToKey(&current_scan_target_);
+      col_idx++;
+      continue;
+    }
+
     const auto& choices = (*range_cols_scan_options_)[col_idx];
     auto& it = current_scan_target_idxs_[col_idx];
 
@@ -269,7 +352,7 @@ Status DiscreteScanChoices::SkipTargetsUpTo(const Slice& new_target) {
   // leftover columns (i.e. set all following indexes to 0).
   for (size_t i = col_idx; i < current_scan_target_idxs_.size(); i++) {
     current_scan_target_idxs_[i] = (*range_cols_scan_options_)[i].begin();
-    current_scan_target_idxs_[i]->AppendToKey(&current_scan_target_);
+    AppendFirstOptionToKey(i, &current_scan_target_);
   }
 
   current_scan_target_.AppendValueType(ValueType::kGroupEnd);
@@ -478,15 +561,34 @@ DocRowwiseIterator::DocRowwiseIterator(
 DocRowwiseIterator::~DocRowwiseIterator() {
 }
 
-Status DocRowwiseIterator::Init() {
+Status DocRowwiseIterator::CreateIterator(
+    BloomFilterMode bloom_filter_mode, const boost::optional<const Slice>& user_key_for_filter,
+    rocksdb::QueryId query_id, std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
   db_iter_ = CreateIntentAwareIterator(
-      doc_db_,
+      doc_db_, bloom_filter_mode, user_key_for_filter, query_id, txn_op_context_, deadline_,
+      read_time_, file_filter);
+  if (!FLAGS_docdb_skip_sst_files_by_table_tombstone || !schema_.has_pgtable_id()) {
+    return Status::OK();
+  }
+  // Table tombstone is looked up by the created iterator, that also saves GetSubDocument this seek.
+  // The iterator is recreated only when the table was deleted, so SST files filter is applied.
+  KeyBytes table_key;
+  DocKeyEncoder(&table_key).Schema(schema_);
+  table_tombstone_time_ = VERIFY_RESULT(GetTableTombstoneTime(table_key, db_iter_.get()));
+  if (table_tombstone_time_ != DocHybridTime::kMin) {
+    db_iter_ = CreateIntentAwareIterator(
+        doc_db_, bloom_filter_mode, user_key_for_filter, query_id, txn_op_context_, deadline_,
+        read_time_, AddTableTombstoneFileFilter(table_tombstone_time_, std::move(file_filter)));
+  }
+  return Status::OK();
+}
+
+Status DocRowwiseIterator::Init() {
+  RETURN_NOT_OK(CreateIterator(
       BloomFilterMode::DONT_USE_BLOOM_FILTER,
       boost::none /* user_key_for_filter */,
       rocksdb::kDefaultQueryId,
-      txn_op_context_,
-      deadline_,
-      read_time_);
+      nullptr /* file_filter */));
 
   DocKeyEncoder(&iter_key_).Schema(schema_);
   row_key_ = iter_key_;
@@ -519,7 +621,8 @@ Result<bool> DocRowwiseIterator::InitScanChoices(
     const DocPgsqlScanSpec& doc_spec, const KeyBytes& lower_doc_key,
     const KeyBytes& upper_doc_key) {
   if (doc_spec.range_options()) {
-    scan_choices_.reset(new DiscreteScanChoices(doc_spec, lower_doc_key, upper_doc_key));
+    scan_choices_.reset(
+        new DiscreteScanChoices(schema_, doc_spec, lower_doc_key, upper_doc_key));
     // Let's not seek to the lower doc key or upper doc key. We know exactly what we want.
     RETURN_NOT_OK(AdvanceIteratorToNextDesiredRow());
     return true;
@@ -550,9 +653,8 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
-  db_iter_ = CreateIntentAwareIterator(
-      doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+  RETURN_NOT_OK(CreateIterator(
+      mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), doc_spec.CreateFileFilter()));
 
   row_ready_ = false;
 
@@ -892,6 +994,7 @@ Result<bool> DocRowwiseIterator::SeekTuple(const Slice& tuple_id) {
 
   iter_key_.Clear();
   row_ready_ = false;
+  done_ = false;
 
   return VERIFY_RESULT(HasNext()) && VERIFY_RESULT(GetTupleId()) == tuple_id;
 }
@@ -38,6 +38,8 @@ namespace docdb {
 class IntentAwareIterator;
 class ScanChoices;
 
+enum class BloomFilterMode;
+
 // An SQL-mapped-to-document-DB iterator.
 class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
  public:
@@ -104,7 +106,8 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   Result<Slice> GetTupleId() const override;
 
   // Seeks to the given tuple by its id. The tuple id should be the serialized DocKey and without
-  // the cotable id.
+  // the cotable id. When tuples are looked up in ascending order, the iterator moves forward and
+  // nearby tuples are reached with Next instead of Seek (see FLAGS_max_nexts_to_avoid_seek).
   Result<bool> SeekTuple(const Slice& tuple_id) override;
 
   // Retrieves the next key to read after the iterator finishes for the given page.
@@ -157,6 +160,12 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Read next row into a value map using the specified projection.
   CHECKED_STATUS DoNextRow(const Schema& projection, QLTableRow* table_row) override;
 
+  // Creates db_iter_. For colocated tables also looks up the table tombstone ahead of the scan,
+  // to skip SST files that contain only records deleted by it.
+  CHECKED_STATUS CreateIterator(
+      BloomFilterMode bloom_filter_mode, const boost::optional<const Slice>& user_key_for_filter,
+      rocksdb::QueryId query_id, std::shared_ptr<rocksdb::ReadFileFilter> file_filter);
+
   const Schema& projection_;
   // Used to maintain ownership of projection_.
   // Separate field is used since ownership could be optional.
@@ -73,6 +73,7 @@ using namespace std::chrono_literals;
 
 DECLARE_bool(use_docdb_aware_bloom_filter);
 DECLARE_int32(max_nexts_to_avoid_seek);
+DECLARE_bool(docdb_skip_sst_files_by_hybrid_time);
 DECLARE_bool(TEST_docdb_sort_weak_intents_in_tests);
 
 #define ASSERT_DOC_DB_DEBUG_DUMP_STR_EQ(str) ASSERT_NO_FATALS(AssertDocDbDebugDumpStrEq(str))
@@ -2842,6 +2843,43 @@ TEST_P(DocDBTestWrapper, BloomFilterTest) {
   ASSERT_NO_FATALS(CheckBloom(2, &total_bloom_useful, 2, &total_table_iterators));
 }
 
+TEST_P(DocDBTestWrapper, HybridTimeFileFilter) {
+  auto dwb = MakeDocWriteBatch();
+  DocKey key(0, PrimitiveValues("key"), PrimitiveValues());
+  const auto encoded_subdoc_key = SubDocKey(key).EncodeWithoutHt();
+
+  // Each file contains the same key, so only hybrid time could be used to exclude them.
+  for (uint64_t value : {1000, 2000}) {
+    dwb.Clear();
+    ASSERT_OK(dwb.SetPrimitive(
+        DocPath(key.Encode()), PrimitiveValue(Format("value$0", value))));
+    ASSERT_OK(WriteToRocksDB(dwb, HybridTime(value)));
+    ASSERT_OK(FlushRocksDbAndWait());
+  }
+
+  auto check_read = [this, &encoded_subdoc_key](
+      const ReadHybridTime& read_time, const std::string& expected_value,
+      int expected_num_iterators) {
+    const auto num_iterators_before =
+        regular_db_options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+    SubDocument doc_from_rocksdb;
+    bool subdoc_found_in_rocksdb = false;
+    GetSubDoc(encoded_subdoc_key, &doc_from_rocksdb, &subdoc_found_in_rocksdb,
+              kNonTransactionalOperationContext, read_time);
+    ASSERT_TRUE(subdoc_found_in_rocksdb);
+    ASSERT_EQ(expected_value, doc_from_rocksdb.ToString());
+    ASSERT_EQ(num_iterators_before + expected_num_iterators,
+              regular_db_options().statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS));
+  };
+
+  ASSERT_NO_FATALS(check_read(ReadHybridTime::SingleTime(HybridTime(1500)), "\"value1000\"", 1));
+  ASSERT_NO_FATALS(check_read(ReadHybridTime::SingleTime(HybridTime(2000)), "\"value2000\"", 2));
+  ASSERT_NO_FATALS(check_read(ReadHybridTime::Max(), "\"value2000\"", 2));
+
+  FLAGS_docdb_skip_sst_files_by_hybrid_time = false;
+  ASSERT_NO_FATALS(check_read(ReadHybridTime::SingleTime(HybridTime(1500)), "\"value1000\"", 2));
+}
+
 TEST_P(DocDBTestWrapper, BloomFilterCorrectness) {
   // Write batch and flush options.
   auto dwb = MakeDocWriteBatch();
@@ -3709,6 +3747,48 @@ TEST_P(DocDBTestWrapper, SetHybridTimeFilter) {
 
 }
 
+// Blocks evicted from the block cache are read from the compressed block cache instead of the file.
+TEST_P(DocDBTestWrapper, CompressedBlockCache) {
+  for (int i = 1; i <= 10; ++i) {
+    ASSERT_OK(WriteSimple(i));
+  }
+  ASSERT_OK(FlushRocksDbAndWait());
+  CloseRocksDB();
+
+  tablet::TabletOptions tablet_options;
+  tablet_options.block_cache = rocksdb::NewLRUCache(1_MB);
+  tablet_options.block_cache_compressed = rocksdb::NewClockCache(1_MB, 0 /* num_shard_bits */);
+  rocksdb::Options options;
+  auto statistics = rocksdb::CreateDBStatistics();
+  docdb::InitRocksDBOptions(&options, "" /* log_prefix */, statistics, tablet_options);
+  ASSERT_NE(rocksdb::kNoCompression, options.compression);
+
+  rocksdb::DB* db = nullptr;
+  ASSERT_OK(rocksdb::DB::Open(options, rocksdb_dir_, &db));
+  std::unique_ptr<rocksdb::DB> db_holder(db);
+  auto count_records = [db] {
+    rocksdb::ReadOptions read_opts;
+    read_opts.query_id = rocksdb::kDefaultQueryId;
+    std::unique_ptr<rocksdb::Iterator> iter(db->NewIterator(read_opts));
+    size_t result = 0;
+    for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+      ++result;
+    }
+    return result;
+  };
+
+  ASSERT_EQ(10U, count_records());
+  ASSERT_EQ(0U, statistics->getTickerCount(rocksdb::BLOCK_CACHE_COMPRESSED_HIT));
+  ASSERT_GT(statistics->getTickerCount(rocksdb::BLOCK_CACHE_COMPRESSED_ADD), 0U);
+
+  // Drop all blocks from the cache of uncompressed blocks.
+  tablet_options.block_cache->SetCapacity(0);
+  tablet_options.block_cache->SetCapacity(1_MB);
+
+  ASSERT_EQ(10U, count_records());
+  ASSERT_GT(statistics->getTickerCount(rocksdb::BLOCK_CACHE_COMPRESSED_HIT), 0U);
+}
+
 void Append(const char* a, const char* b, std::string* out) {
   out->append(a, b);
 }
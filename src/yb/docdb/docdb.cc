@@ -51,6 +51,7 @@
 
 #include "yb/util/bitmap.h"
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/date_time.h"
 #include "yb/util/enums.h"
 #include "yb/util/flag_tags.h"
@@ -58,6 +59,7 @@
 #include "yb/util/metrics.h"
 #include "yb/util/pb_util.h"
 #include "yb/util/status.h"
+#include "yb/util/threadpool.h"
 
 #include "yb/yql/cql/ql/util/errcodes.h"
 
@@ -87,6 +89,15 @@ DEFINE_int32(txn_max_apply_batch_records, 100000,
              "Max number of apply records allowed in single RocksDB batch. "
              "When a transaction's data in one tablet does not fit into specified number of "
              "records, it will be applied using multiple RocksDB write batches.");
+DEFINE_int32(txn_apply_intents_max_parts, 4,
+             "Max number of parts that a single apply batch of a transaction is split into, so "
+             "intents of each part are looked up by a separate thread. Used only when the apply "
+             "intents thread pool is enabled.");
+TAG_FLAG(txn_apply_intents_max_parts, advanced);
+DEFINE_int32(txn_apply_intents_min_part_records, 10000,
+             "Min number of strong write intents in a part of apply batch, that is processed by "
+             "a separate thread.");
+TAG_FLAG(txn_apply_intents_min_part_records, advanced);
 
 namespace yb {
 namespace docdb {
@@ -1076,6 +1087,86 @@ ApplyTransactionState StoreApplyState(
   return result;
 }
 
+namespace {
+
+// Reverse index record key and value, i.e. key of the original intent record.
+// Only records of strong write intents are collected, since other intents are not applied.
+typedef std::pair<std::string, std::string> ReverseIndexRecord;
+
+class CopyToWriteBatchHandler : public rocksdb::WriteBatch::Handler {
+ public:
+  explicit CopyToWriteBatchHandler(rocksdb::WriteBatch* dest) : dest_(dest) {}
+
+  void Put(const Slice& key, const Slice& value) override {
+    dest_->Put(key, value);
+  }
+
+ private:
+  rocksdb::WriteBatch* dest_;
+};
+
+// Converts intents referenced by specified reverse index records to regular records.
+// Records are split into contiguous parts, and intents of each part are looked up by its own
+// thread of apply_pool. Regular records are appended to regular_batch in the reverse index order.
+// Since write id of regular record is taken from its intent, the result does not depend on the
+// number of parts.
+CHECKED_STATUS ApplyIntentsInParallel(
+    const Slice& transaction_id_slice, HybridTime commit_ht, const KeyBounds* key_bounds,
+    const std::vector<ReverseIndexRecord>& records, rocksdb::DB* intents_db,
+    ThreadPool* apply_pool, rocksdb::WriteBatch* regular_batch, IntraTxnWriteId* write_id) {
+  const size_t num_parts = std::max<size_t>(std::min<size_t>(
+      FLAGS_txn_apply_intents_max_parts,
+      records.size() / std::max(FLAGS_txn_apply_intents_min_part_records, 1)), 1);
+
+  // The first part is written directly to regular_batch.
+  std::vector<rocksdb::WriteBatch> part_batches(num_parts - 1);
+  std::vector<IntraTxnWriteId> part_write_ids(num_parts, *write_id);
+  std::vector<Status> statuses(num_parts);
+  auto apply_part = [&](size_t part) {
+    auto intent_iter = CreateRocksDBIterator(
+        intents_db, key_bounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
+        rocksdb::kDefaultQueryId);
+    auto* batch = part == 0 ? regular_batch : &part_batches[part - 1];
+    const size_t end = records.size() * (part + 1) / num_parts;
+    for (size_t i = records.size() * part / num_parts; i != end; ++i) {
+      statuses[part] = IntentToWriteRequest(
+          transaction_id_slice, commit_ht, records[i].first, records[i].second, &intent_iter,
+          batch, &part_write_ids[part]);
+      if (!statuses[part].ok()) {
+        break;
+      }
+    }
+  };
+
+  CountDownLatch latch(num_parts - 1);
+  for (size_t part = 1; part != num_parts; ++part) {
+    auto submit_status = apply_pool->SubmitFunc([&apply_part, &latch, part] {
+      apply_part(part);
+      latch.CountDown();
+    });
+    if (!submit_status.ok()) {
+      // Pool could be shutting down, apply this part in the current thread.
+      apply_part(part);
+      latch.CountDown();
+    }
+  }
+  apply_part(0);
+  latch.Wait();
+
+  for (const auto& status : statuses) {
+    RETURN_NOT_OK(status);
+  }
+
+  CopyToWriteBatchHandler handler(regular_batch);
+  for (const auto& batch : part_batches) {
+    RETURN_NOT_OK(batch.Iterate(&handler));
+  }
+  *write_id = *std::max_element(part_write_ids.begin(), part_write_ids.end());
+  return Status::OK();
+}
+
+} // namespace
+
 Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId& transaction_id,
     HybridTime commit_ht,
@@ -1083,7 +1174,8 @@ Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const ApplyTransactionState* apply_state,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db,
-    rocksdb::WriteBatch* intents_batch) {
+    rocksdb::WriteBatch* intents_batch,
+    ThreadPool* apply_pool) {
   SCHECK_EQ((regular_batch != nullptr) + (intents_batch != nullptr), 1, InvalidArgument,
             "Exactly one write batch should be non-null, either regular or intents");
 
@@ -1104,10 +1196,15 @@ Result<ApplyTransactionState> PrepareApplyIntentsBatch(
 
   BoundedRocksDbIterator intent_iter;
 
+  // In parallel mode reverse index records of the batch are collected first, and then their
+  // intents are looked up by apply_pool.
+  const bool parallel = regular_batch && apply_pool && FLAGS_txn_apply_intents_max_parts > 1;
+  std::vector<ReverseIndexRecord> records;
+
   // If we don't have regular_batch, it means that we are just removing intents, i.e. when a
   // transaction has been aborted. We don't need the intent iterator in that case, because the
   // reverse index iterator is sufficient.
-  if (regular_batch) {
+  if (regular_batch && !parallel) {
     intent_iter = CreateRocksDBIterator(
         intents_db, key_bounds, BloomFilterMode::DONT_USE_BLOOM_FILTER, boost::none,
         rocksdb::kDefaultQueryId);
@@ -1161,13 +1258,27 @@ Result<ApplyTransactionState> PrepareApplyIntentsBatch(
           (!key_bounds || key_bounds->IsWithinBounds(reverse_index_iter.value()))) {
         // We store apply state only if there are some more intents left.
         // So doing this check here, instead of right after write_id was incremented.
-        if (write_id >= write_id_limit) {
+        if (parallel ? records.size() >= max_records : write_id >= write_id_limit) {
+          if (parallel) {
+            RETURN_NOT_OK(ApplyIntentsInParallel(
+                transaction_id_slice, commit_ht, key_bounds, records, intents_db, apply_pool,
+                regular_batch, &write_id));
+          }
           return StoreApplyState(
               transaction_id_slice, key_slice, write_id, commit_ht, regular_batch);
         }
-        RETURN_NOT_OK(IntentToWriteRequest(
-            transaction_id_slice, commit_ht, key_slice, reverse_index_value,
-            &intent_iter, regular_batch, &write_id));
+        if (parallel) {
+          // Only strong write intents produce regular records and have write ids. So only they
+          // are collected, and limited by max_records, as write ids are in the sequential mode.
+          auto intent = VERIFY_RESULT(ParseIntentKey(reverse_index_value, transaction_id_slice));
+          if (intent.types.Test(IntentType::kStrongWrite)) {
+            records.emplace_back(key_slice.ToBuffer(), reverse_index_value.ToBuffer());
+          }
+        } else {
+          RETURN_NOT_OK(IntentToWriteRequest(
+              transaction_id_slice, commit_ht, key_slice, reverse_index_value,
+              &intent_iter, regular_batch, &write_id));
+        }
       }
 
       if (intents_batch) {
@@ -1189,6 +1300,12 @@ Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     reverse_index_iter.Next();
   }
 
+  if (!records.empty()) {
+    RETURN_NOT_OK(ApplyIntentsInParallel(
+        transaction_id_slice, commit_ht, key_bounds, records, intents_db, apply_pool,
+        regular_batch, &write_id));
+  }
+
   if (apply_state && regular_batch) {
     char tombstone_value_type = ValueTypeAsChar::kTombstone;
     std::array<Slice, 1> value_parts = {{Slice(&tombstone_value_type, 1)}};
@@ -81,6 +81,7 @@
 namespace yb {
 
 class Histogram;
+class ThreadPool;
 
 namespace docdb {
 
@@ -221,6 +222,8 @@ struct ApplyTransactionState {
   }
 };
 
+// When apply_pool is specified, intents of the batch are looked up by multiple threads of this pool.
+// The calling thread waits for them, so the pool should not be used on latency sensitive threads.
 Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const TransactionId& transaction_id,
     HybridTime commit_ht,
@@ -228,7 +231,8 @@ Result<ApplyTransactionState> PrepareApplyIntentsBatch(
     const ApplyTransactionState* apply_state,
     rocksdb::WriteBatch* regular_batch,
     rocksdb::DB* intents_db,
-    rocksdb::WriteBatch* intents_batch);
+    rocksdb::WriteBatch* intents_batch,
+    ThreadPool* apply_pool = nullptr);
 
 void AppendTransactionKeyPrefix(const TransactionId& transaction_id, docdb::KeyBytes* out);
 
@@ -365,6 +365,10 @@ const char* DocDBCompactionFilterFactory::Name() const {
   return "DocDBCompactionFilterFactory";
 }
 
+Result<Slice> DocDBCompactionFilterFactory::GetSubcompactionBoundary(Slice user_key) {
+  return user_key.Prefix(VERIFY_RESULT(DocKey::EncodedSize(user_key, DocKeyPart::kWholeDocKey)));
+}
+
 // ------------------------------------------------------------------------------------------------
 
 HistoryRetentionDirective ManualHistoryRetentionPolicy::GetRetentionDirective() {
@@ -170,6 +170,10 @@ class DocDBCompactionFilterFactory : public rocksdb::CompactionFilterFactory {
       const rocksdb::CompactionFilter::Context& context) override;
   const char* Name() const override;
 
+  // The compaction filter tracks overwrites within a document, so subcompactions are split by
+  // DocKey.
+  Result<Slice> GetSubcompactionBoundary(Slice user_key) override;
+
  private:
   std::shared_ptr<HistoryRetentionPolicy> retention_policy_;
   const KeyBounds* key_bounds_;
@@ -26,12 +26,14 @@ class DocPath;
 class DocWriteBatch;
 class IntentAwareIterator;
 class KeyValueWriteBatchPB;
+class LockBatch;
 class PgsqlWriteOperation;
 class QLWriteOperation;
 class SubDocKey;
 
 struct ApplyTransactionState;
 struct DocDB;
+struct PgsqlParallelScan;
 
 YB_STRONGLY_TYPED_BOOL(PartialRangeKeyIntents);
 
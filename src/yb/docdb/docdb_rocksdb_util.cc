@@ -21,6 +21,7 @@
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
+#include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksdb/db/db_impl.h"
 #include "yb/rocksdb/db/version_edit.h"
 #include "yb/rocksdb/db/version_set.h"
@@ -35,11 +36,13 @@
 #include "yb/rocksutil/yb_rocksdb.h"
 #include "yb/rocksutil/yb_rocksdb_logger.h"
 #include "yb/server/hybrid_clock.h"
+#include "yb/util/path_util.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/size_literals.h"
 #include "yb/util/status.h"
 #include "yb/util/trace.h"
 #include "yb/gutil/sysinfo.h"
+#include "yb/gutil/walltime.h"
 
 using namespace yb::size_literals;  // NOLINT.
 using namespace std::literals;
@@ -66,6 +69,10 @@ DEFINE_uint64(rocksdb_universal_compaction_always_include_size_threshold, 64_MB,
              "Always include files of smaller or equal size in a compaction.");
 DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximum number of key range subcompactions a single compaction could be split into. "
+             "Subcompactions are only formed for compactions of at least "
+             "min_subcompaction_size_bytes per subcompaction.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
@@ -74,6 +81,30 @@ DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
              "Maximal allowed file size to participate in RocksDB compaction. 0 - unlimited.");
 DEFINE_int32(rocksdb_max_write_buffer_number, 2,
              "Maximum number of write buffers that are built up in memory.");
+DEFINE_int32(rocksdb_max_prefetched_data_blocks, 8,
+             "Maximum number of data blocks that a sequential scan keeps prefetched into the block "
+             "cache ahead of its position. Only used when data block prefetch pool is enabled.");
+DEFINE_bool(rocksdb_cache_index_and_filter_blocks_with_high_priority, true,
+            "Insert index and bloom filter blocks directly into the multi-touch part of the block "
+            "cache, so they are not evicted by data blocks read once by scans.");
+DEFINE_int32(rocksdb_compression_dict_bytes, 0,
+             "Maximum size of the dictionary, that is built for each SST file from samples of its "
+             "data blocks and used to compress them. 0 - dictionary is not used. Snappy does not "
+             "support dictionaries, so when it is set, SST files are compressed with LZ4 instead. "
+             "SST files with dictionary could not be read by releases before it was added, so it "
+             "should not be set until all servers are upgraded, and they could not be "
+             "downgraded after that.");
+DEFINE_bool(rocksdb_use_direct_reads, false,
+            "Read SST files with O_DIRECT, so data blocks that are already cached by the block "
+            "cache do not occupy OS page cache.");
+DEFINE_string(rocksdb_cold_data_dir, "",
+              "Directory for SST files of the regular DB that contain only data older than "
+              "rocksdb_cold_data_age_secs. Such files are written there by compactions, so it "
+              "could be placed on cheaper storage. Empty - all SST files are kept in the "
+              "tablet RocksDB dir.");
+DEFINE_int64(rocksdb_cold_data_age_secs, 7 * 24 * 60 * 60,
+             "Minimal age of the newest record in compaction output, for it to be placed in "
+             "rocksdb_cold_data_dir.");
 
 DEFINE_int64(db_block_size_bytes, 32_KB,
              "Size of RocksDB data block (in bytes).");
@@ -114,6 +145,14 @@ DEFINE_int32(priority_thread_pool_size, -1,
              "If -1 and max_background_compactions is specified - use max_background_compactions. "
              "If -1 and max_background_compactions is not specified - use sqrt(num_cpus).");
 
+DEFINE_bool(docdb_skip_sst_files_by_hybrid_time, true,
+            "Whether reads should skip regular DB SST files that contain only records written "
+            "after the read time.");
+
+DEFINE_bool(docdb_skip_sst_files_by_table_tombstone, true,
+            "Whether reads from a truncated colocated table should skip regular DB SST files that "
+            "contain only records written before the table tombstone.");
+
 using std::shared_ptr;
 using std::string;
 using std::unique_ptr;
@@ -123,6 +162,7 @@ namespace yb {
 namespace docdb {
 
 std::shared_ptr<rocksdb::BoundaryValuesExtractor> DocBoundaryValuesExtractorInstance();
+rocksdb::UserBoundaryTag TagForDocHybridTime();
 
 void SeekForward(const rocksdb::Slice& slice, rocksdb::Iterator *iter) {
   if (!iter->Valid() || iter->key().compare(slice) >= 0) {
@@ -231,8 +271,90 @@ rocksdb::ReadOptions PrepareReadOptions(
   return read_opts;
 }
 
+// Skips SST files whose oldest record was written after max_hybrid_time, so no record of such file
+// could be visible to the read. Files without hybrid time boundaries are never skipped.
+class HybridTimeFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  HybridTimeFileFilter(
+      HybridTime max_hybrid_time, std::shared_ptr<rocksdb::ReadFileFilter> base_filter)
+      : max_hybrid_time_(max_hybrid_time), base_filter_(std::move(base_filter)) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    if (base_filter_ && !base_filter_->Filter(file)) {
+      return false;
+    }
+    // Hybrid time boundary values are ordered by hybrid time, so smallest one is the oldest
+    // record of the file.
+    const Slice* smallest = file.smallest.user_value_with_tag(TagForDocHybridTime());
+    if (!smallest) {
+      return true;
+    }
+    DocHybridTime min_doc_ht;
+    if (!min_doc_ht.FullyDecodeFrom(*smallest).ok()) {
+      return true;
+    }
+    return min_doc_ht.hybrid_time() <= max_hybrid_time_;
+  }
+
+ private:
+  const HybridTime max_hybrid_time_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> base_filter_;
+};
+
+// Records written after global limit of the read time are ignored by IntentAwareIterator, so files
+// that contain only such records do not have to be opened at all.
+std::shared_ptr<rocksdb::ReadFileFilter> AddHybridTimeFileFilter(
+    const ReadHybridTime& read_time, std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
+  if (!FLAGS_docdb_skip_sst_files_by_hybrid_time || !read_time.global_limit.is_valid() ||
+      read_time.global_limit == HybridTime::kMax) {
+    return file_filter;
+  }
+  return std::make_shared<HybridTimeFileFilter>(read_time.global_limit, std::move(file_filter));
+}
+
+// All records of the read colocated table, that were written before the table tombstone, are
+// deleted. So file that contains only such records does not have anything visible for the read,
+// even though it could contain live records of other tables of the same tablet.
+class TableTombstoneFileFilter : public rocksdb::ReadFileFilter {
+ public:
+  TableTombstoneFileFilter(
+      DocHybridTime table_tombstone_time, std::shared_ptr<rocksdb::ReadFileFilter> base_filter)
+      : table_tombstone_time_(table_tombstone_time), base_filter_(std::move(base_filter)) {
+  }
+
+  bool Filter(const rocksdb::FdWithBoundaries& file) const override {
+    if (base_filter_ && !base_filter_->Filter(file)) {
+      return false;
+    }
+    // Largest hybrid time boundary value is the newest record of the file.
+    const Slice* largest = file.largest.user_value_with_tag(TagForDocHybridTime());
+    if (!largest) {
+      return true;
+    }
+    DocHybridTime max_doc_ht;
+    if (!max_doc_ht.FullyDecodeFrom(*largest).ok()) {
+      return true;
+    }
+    return max_doc_ht >= table_tombstone_time_;
+  }
+
+ private:
+  const DocHybridTime table_tombstone_time_;
+  const std::shared_ptr<rocksdb::ReadFileFilter> base_filter_;
+};
+
 } // namespace
 
+std::shared_ptr<rocksdb::ReadFileFilter> AddTableTombstoneFileFilter(
+    DocHybridTime table_tombstone_time, std::shared_ptr<rocksdb::ReadFileFilter> file_filter) {
+  if (!FLAGS_docdb_skip_sst_files_by_table_tombstone || !table_tombstone_time.is_valid() ||
+      table_tombstone_time == DocHybridTime::kMin) {
+    return file_filter;
+  }
+  return std::make_shared<TableTombstoneFileFilter>(table_tombstone_time, std::move(file_filter));
+}
+
 BoundedRocksDbIterator CreateRocksDBIterator(
     rocksdb::DB* rocksdb,
     const KeyBounds* docdb_key_bounds,
@@ -258,7 +380,8 @@ unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     const Slice* iterate_upper_bound) {
   // TODO(dtxn) do we need separate options for intents db?
   rocksdb::ReadOptions read_opts = PrepareReadOptions(doc_db.regular, bloom_filter_mode,
-      user_key_for_filter, query_id, std::move(file_filter), iterate_upper_bound);
+      user_key_for_filter, query_id, AddHybridTimeFileFilter(read_time, std::move(file_filter)),
+      iterate_upper_bound);
   return std::make_unique<IntentAwareIterator>(
       doc_db, read_opts, deadline, read_time, txn_op_context);
 }
@@ -401,6 +524,7 @@ void InitRocksDBOptions(
   options->initial_seqno = FLAGS_initial_seqno;
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
   options->compaction_measure_io_stats = FLAGS_rocksdb_compaction_measure_io_stats;
+  options->use_direct_reads = FLAGS_rocksdb_use_direct_reads;
   options->memory_monitor = tablet_options.memory_monitor;
   if (FLAGS_db_write_buffer_size != -1) {
     options->write_buffer_size = FLAGS_db_write_buffer_size;
@@ -418,8 +542,19 @@ void InitRocksDBOptions(
     options->num_reserved_small_compaction_threads = FLAGS_num_reserved_small_compaction_threads;
   }
 
-  options->compression = rocksdb::Snappy_Supported() && FLAGS_enable_ondisk_compression
-      ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  if (!FLAGS_enable_ondisk_compression) {
+    options->compression = rocksdb::kNoCompression;
+  } else if (FLAGS_rocksdb_compression_dict_bytes > 0 &&
+             rocksdb::CompressionDictSupported(rocksdb::kLZ4Compression)) {
+    // LZ4 is as fast as Snappy, so dictionary does not make compression noticeably slower.
+    options->compression = rocksdb::kLZ4Compression;
+    options->compression_opts.max_dict_bytes = FLAGS_rocksdb_compression_dict_bytes;
+  } else {
+    LOG_IF(WARNING, FLAGS_rocksdb_compression_dict_bytes > 0)
+        << "LZ4 compression dictionary is not supported, rocksdb_compression_dict_bytes ignored";
+    options->compression = rocksdb::Snappy_Supported()
+        ? rocksdb::kSnappyCompression : rocksdb::kNoCompression;
+  }
 
   options->listeners.insert(
       options->listeners.end(), tablet_options.listeners.begin(),
@@ -431,6 +566,15 @@ void InitRocksDBOptions(
     table_options.block_cache = tablet_options.block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
+    table_options.cache_index_and_filter_blocks_with_high_priority =
+        FLAGS_rocksdb_cache_index_and_filter_blocks_with_high_priority;
+    table_options.data_block_prefetch_pool = tablet_options.data_block_prefetch_pool;
+    table_options.max_prefetched_data_blocks =
+        std::max(FLAGS_rocksdb_max_prefetched_data_blocks, 0);
+    // Compressed blocks cache is useless when blocks are not compressed.
+    if (options->compression != rocksdb::kNoCompression) {
+      table_options.block_cache_compressed = tablet_options.block_cache_compressed;
+    }
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
@@ -488,6 +632,8 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
+    options->max_subcompactions =
+        static_cast<uint32_t>(std::max(FLAGS_rocksdb_max_subcompactions, 1));
     if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
       options->rate_limiter.reset(
           rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
@@ -515,6 +661,38 @@ void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix) {
   options->info_log = std::make_shared<YBRocksDBLogger>(options->log_prefix);
 }
 
+std::string ColdDataDir(const std::string& db_dir) {
+  if (FLAGS_rocksdb_cold_data_dir.empty()) {
+    return std::string();
+  }
+  // Keep the table-<id>/tablet-<id> layout of the data dir, so tablets do not clash.
+  return JoinPathSegments(
+      FLAGS_rocksdb_cold_data_dir, BaseName(DirName(db_dir)), BaseName(db_dir));
+}
+
+void SetColdDataPath(const std::string& db_dir, rocksdb::Options* options) {
+  auto cold_dir = ColdDataDir(db_dir);
+  if (cold_dir.empty()) {
+    return;
+  }
+  // Target sizes are not limited, so files are moved between paths only by the selector.
+  options->db_paths = {
+      rocksdb::DbPath(db_dir, std::numeric_limits<uint64_t>::max()),
+      rocksdb::DbPath(cold_dir, std::numeric_limits<uint64_t>::max()),
+  };
+  auto selector = [](const rocksdb::UserFrontier& largest) -> uint32_t {
+    auto hybrid_time = down_cast<const ConsensusFrontier&>(largest).hybrid_time();
+    if (!hybrid_time.is_valid()) {
+      return 0;
+    }
+    auto age_us = static_cast<int64_t>(GetCurrentTimeMicros()) -
+                  static_cast<int64_t>(hybrid_time.GetPhysicalValueMicros());
+    return age_us >= FLAGS_rocksdb_cold_data_age_secs * 1000000 ? 1 : 0;
+  };
+  options->compaction_output_path_selector =
+      std::make_shared<rocksdb::CompactionOutputPathSelector>(std::move(selector));
+}
+
 namespace {
 
 // Helper class for RocksDBPatcher.
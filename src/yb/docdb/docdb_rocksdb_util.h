@@ -102,6 +102,11 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
     std::shared_ptr<rocksdb::ReadFileFilter> file_filter = nullptr,
     const Slice* iterate_upper_bound = nullptr);
 
+// Wraps file_filter of a read from colocated table deleted at table_tombstone_time, so regular DB
+// SST files that contain only records written before the tombstone are skipped. Returns
+// file_filter unchanged if there is no table tombstone.
+std::shared_ptr<rocksdb::ReadFileFilter> AddTableTombstoneFileFilter(
+    DocHybridTime table_tombstone_time, std::shared_ptr<rocksdb::ReadFileFilter> file_filter);
 
 // Return true if the DB has a currently pending compaction.
 bool HasPendingCompaction(rocksdb::DB* db);
@@ -124,6 +129,14 @@ void InitRocksDBOptions(
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
 
+// Returns directory for cold SST files of the RocksDB located in db_dir, or empty string if
+// rocksdb_cold_data_dir is not specified.
+std::string ColdDataDir(const std::string& db_dir);
+
+// Makes compactions place their output to the cold data dir, when all input files contain only
+// data older than rocksdb_cold_data_age_secs. Does nothing if cold data dir is not specified.
+void SetColdDataPath(const std::string& db_dir, rocksdb::Options* options);
+
 // Class to edit RocksDB manifest w/o fully loading DB into memory.
 class RocksDBPatcher {
  public:
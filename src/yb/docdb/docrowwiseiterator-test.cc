@@ -13,6 +13,7 @@
 
 #include <memory>
 #include <string>
+#include <tuple>
 
 #include "yb/common/ql_expr.h"
 #include "yb/common/ql_value.h"
@@ -34,6 +35,7 @@
 #include "yb/util/test_util.h"
 
 DECLARE_bool(TEST_docdb_sort_weak_intents_in_tests);
+DECLARE_bool(docdb_skip_sst_files_by_table_tombstone);
 
 namespace yb {
 namespace docdb {
@@ -656,6 +658,70 @@ SubDocKey(DocKey(PgTableId=16385, [], ["row1", 11111]), [SystemColumnId(0); HT{
   }
 }
 
+TEST_F(DocRowwiseIteratorTest, ColocatedTableTombstoneSkipFilesTest) {
+  constexpr PgTableOid pgtable_id(0x4001);
+  auto dwb = MakeDocWriteBatch();
+
+  DocKey encoded_1_with_tableid;
+  ASSERT_OK(encoded_1_with_tableid.FullyDecodeFrom(kEncodedDocKey1));
+  encoded_1_with_tableid.set_pgtable_id(pgtable_id);
+  DocKey encoded_2_with_tableid;
+  ASSERT_OK(encoded_2_with_tableid.FullyDecodeFrom(kEncodedDocKey2));
+  encoded_2_with_tableid.set_pgtable_id(pgtable_id);
+
+  // file1: row1 written before the table tombstone.
+  // file2: table tombstone.
+  // file3: row2 written after the table tombstone.
+  ASSERT_OK(dwb.SetPrimitive(
+      DocPath(
+        encoded_1_with_tableid.Encode(),
+        PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn)),
+      PrimitiveValue(ValueType::kNullLow)));
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(1000)));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  DocKey table_id(pgtable_id);
+  ASSERT_OK(dwb.DeleteSubDoc(DocPath(table_id.Encode())));
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(2000)));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  ASSERT_OK(dwb.SetPrimitive(
+      DocPath(
+        encoded_2_with_tableid.Encode(),
+        PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn)),
+      PrimitiveValue(ValueType::kNullLow)));
+  ASSERT_OK(WriteToRocksDBAndClear(&dwb, HybridTime::FromMicros(3000)));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  Schema schema_copy = kSchemaForIteratorTests;
+  schema_copy.set_pgtable_id(pgtable_id);
+  Schema projection;
+  auto* statistics = regular_db_options().statistics.get();
+
+  for (bool skip_files : {false, true}) {
+    SCOPED_TRACE(Format("skip_files: $0", skip_files));
+    FLAGS_docdb_skip_sst_files_by_table_tombstone = skip_files;
+    const auto table_iterators_before =
+        statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS);
+
+    DocRowwiseIterator iter(
+        projection, schema_copy, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::Max());
+    ASSERT_OK(iter.Init());
+    QLTableRow row;
+    ASSERT_TRUE(ASSERT_RESULT(iter.HasNext()));
+    ASSERT_EQ(encoded_2_with_tableid.Encode().AsSlice(), iter.row_key());
+    ASSERT_OK(iter.NextRow(&row));
+    ASSERT_FALSE(ASSERT_RESULT(iter.HasNext()));
+
+    const auto table_iterators =
+        statistics->getTickerCount(rocksdb::NO_TABLE_CACHE_ITERATORS) - table_iterators_before;
+    // Looking up the table tombstone opens all 3 files, but the scan itself skips file1, whose
+    // records are all older than the table tombstone.
+    ASSERT_EQ(skip_files ? 3 + 2 : 3, table_iterators);
+  }
+}
+
 TEST_F(DocRowwiseIteratorTest, DocRowwiseIteratorMultipleDeletes) {
   auto dwb = MakeDocWriteBatch();
 
@@ -1271,5 +1337,156 @@ TEST_F(DocRowwiseIteratorTest, ScanWithinTheSameTxn) {
   ASSERT_EQ(intents_db_options_.statistics->getTickerCount(rocksdb::Tickers::NUMBER_DB_SEEK), 6);
 }
 
+TEST_F(DocRowwiseIteratorTest, RangeSkipScan) {
+  // Rows ("a", 1) ... ("c", 5), condition is only on the second range column.
+  for (const std::string& a : {"a", "b", "c"}) {
+    for (int64_t b = 1; b <= 5; ++b) {
+      const KeyBytes encoded_doc_key(DocKey(PrimitiveValues(a, b)).Encode());
+      ASSERT_OK(SetPrimitive(
+          DocPath(encoded_doc_key, PrimitiveValue(30_ColId)),
+          PrimitiveValue(a + std::to_string(b)), HybridTime::FromMicros(1000)));
+    }
+  }
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+
+  // Reads the values of the key columns of all rows matching the condition.
+  auto scan = [&](const PgsqlConditionPB& condition) -> Result<std::string> {
+    const std::vector<PrimitiveValue> hashed_components;
+    DocPgsqlScanSpec spec(
+        schema, rocksdb::kDefaultQueryId, hashed_components, &condition,
+        boost::none /* hash_code */, boost::none /* max_hash_code */, nullptr /* where_expr */);
+    EXPECT_TRUE(spec.range_options() != nullptr);
+
+    DocRowwiseIterator iter(
+        projection, schema, kNonTransactionalOperationContext, doc_db(),
+        CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+    RETURN_NOT_OK(iter.Init(spec));
+    std::string result;
+    while (VERIFY_RESULT(iter.HasNext())) {
+      QLTableRow row;
+      RETURN_NOT_OK(iter.NextRow(&row));
+      QLValue a, b;
+      RETURN_NOT_OK(row.GetValue(10_ColId, &a));
+      RETURN_NOT_OK(row.GetValue(20_ColId, &b));
+      result += Format("($0, $1)", a.string_value(), b.int64_value());
+    }
+    return result;
+  };
+
+  // b IN (2, 4)
+  PgsqlConditionPB in_condition;
+  in_condition.set_op(QL_OP_IN);
+  in_condition.add_operands()->set_column_id(20_ColId);
+  auto* list = in_condition.add_operands()->mutable_value()->mutable_list_value();
+  list->add_elems()->set_int64_value(2);
+  list->add_elems()->set_int64_value(4);
+  ASSERT_EQ("(a, 2)(a, 4)(b, 2)(b, 4)(c, 2)(c, 4)", ASSERT_RESULT(scan(in_condition)));
+
+  // a >= "b" AND b IN (2, 4)
+  PgsqlConditionPB and_condition;
+  and_condition.set_op(QL_OP_AND);
+  auto* ge_condition = and_condition.add_operands()->mutable_condition();
+  ge_condition->set_op(QL_OP_GREATER_THAN_EQUAL);
+  ge_condition->add_operands()->set_column_id(10_ColId);
+  ge_condition->add_operands()->mutable_value()->set_string_value("b");
+  *and_condition.add_operands()->mutable_condition() = in_condition;
+  ASSERT_EQ("(b, 2)(b, 4)(c, 2)(c, 4)", ASSERT_RESULT(scan(and_condition)));
+}
+
+TEST_F(DocRowwiseIteratorTest, SeekTupleBatch) {
+  for (const auto& key : { std::make_pair("a", 1), std::make_pair("a", 3),
+                           std::make_pair("b", 2) }) {
+    const KeyBytes encoded_doc_key(
+        DocKey(PrimitiveValues(key.first, static_cast<int64_t>(key.second))).Encode());
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key, PrimitiveValue(30_ColId)),
+        PrimitiveValue(key.first + std::to_string(key.second)), HybridTime::FromMicros(1000)));
+  }
+
+  const Schema &schema = kSchemaForIteratorTests;
+  const Schema &projection = kProjectionForIteratorTests;
+
+  // The same iterator is used for all lookups, like for a batch of ybctids.
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.Init());
+
+  auto lookup = [&iter](const std::string& a, int64_t b) -> Result<std::string> {
+    const KeyBytes tuple_id(DocKey(PrimitiveValues(a, b)).Encode());
+    if (!VERIFY_RESULT(iter.SeekTuple(tuple_id.AsSlice()))) {
+      return std::string();
+    }
+    QLTableRow row;
+    RETURN_NOT_OK(iter.NextRow(&row));
+    QLValue value;
+    RETURN_NOT_OK(row.GetValue(30_ColId, &value));
+    return value.string_value();
+  };
+
+  ASSERT_EQ("a1", ASSERT_RESULT(lookup("a", 1)));
+  ASSERT_EQ("", ASSERT_RESULT(lookup("a", 2)));
+  ASSERT_EQ("a3", ASSERT_RESULT(lookup("a", 3)));
+  ASSERT_EQ("", ASSERT_RESULT(lookup("b", 1)));
+  ASSERT_EQ("b2", ASSERT_RESULT(lookup("b", 2)));
+  ASSERT_EQ("", ASSERT_RESULT(lookup("c", 1)));
+  // Lookup after reaching the end of the table.
+  ASSERT_EQ("a3", ASSERT_RESULT(lookup("a", 3)));
+}
+
+TEST_F(DocRowwiseIteratorTest, SeekTupleBatchHashPartitioned) {
+  const Schema schema({
+          ColumnSchema("a", DataType::STRING, /* is_nullable = */ false, /* is_hash_key = */ true),
+          ColumnSchema("b", DataType::INT64, false),
+          // Non-key columns
+          ColumnSchema("c", DataType::STRING, true)
+      }, {
+          10_ColId,
+          20_ColId,
+          30_ColId
+      }, 2);
+  Schema projection;
+  ASSERT_OK(schema.CreateProjectionByNames({"c"}, &projection));
+
+  auto encoded_doc_key = [](DocKeyHash hash, const std::string& a, int64_t b) {
+    return DocKey(hash, PrimitiveValues(a), PrimitiveValues(b)).Encode();
+  };
+  for (const auto& key : { std::make_tuple(0x9000, "a", 1), std::make_tuple(0x1000, "b", 2),
+                           std::make_tuple(0x5000, "c", 3) }) {
+    ASSERT_OK(SetPrimitive(
+        DocPath(encoded_doc_key(std::get<0>(key), std::get<1>(key), std::get<2>(key)),
+                PrimitiveValue(30_ColId)),
+        PrimitiveValue(std::get<1>(key) + std::to_string(std::get<2>(key))),
+        HybridTime::FromMicros(1000)));
+  }
+
+  // Lookups are done in the binary order of tuple ids, which is ordered by hash first.
+  DocRowwiseIterator iter(
+      projection, schema, kNonTransactionalOperationContext, doc_db(),
+      CoarseTimePoint::max() /* deadline */, ReadHybridTime::FromMicros(2000));
+  ASSERT_OK(iter.Init());
+
+  auto lookup = [&iter, &encoded_doc_key](
+      DocKeyHash hash, const std::string& a, int64_t b) -> Result<std::string> {
+    const KeyBytes tuple_id(encoded_doc_key(hash, a, b));
+    if (!VERIFY_RESULT(iter.SeekTuple(tuple_id.AsSlice()))) {
+      return std::string();
+    }
+    QLTableRow row;
+    RETURN_NOT_OK(iter.NextRow(&row));
+    QLValue value;
+    RETURN_NOT_OK(row.GetValue(30_ColId, &value));
+    return value.string_value();
+  };
+
+  ASSERT_EQ("b2", ASSERT_RESULT(lookup(0x1000, "b", 2)));
+  ASSERT_EQ("c3", ASSERT_RESULT(lookup(0x5000, "c", 3)));
+  ASSERT_EQ("", ASSERT_RESULT(lookup(0x5000, "d", 1)));
+  ASSERT_EQ("a1", ASSERT_RESULT(lookup(0x9000, "a", 1)));
+  ASSERT_EQ("", ASSERT_RESULT(lookup(0x9000, "a", 2)));
+}
+
 }  // namespace docdb
 }  // namespace yb
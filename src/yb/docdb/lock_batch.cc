@@ -38,12 +38,39 @@ LockBatch::~LockBatch() {
 
 void LockBatch::Reset() {
   if (!empty()) {
-    VLOG(1) << "Auto-unlocking a LockBatch with " << size() << " keys";
-    DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+    if (!data_.unlocked) {
+      VLOG(1) << "Auto-unlocking a LockBatch with " << size() << " keys";
+      DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+    }
     data_.key_to_type.clear();
+    data_.unlocked = false;
   }
 }
 
+void LockBatch::Unlock() {
+  if (empty() || data_.unlocked) {
+    return;
+  }
+  VLOG(1) << "Temporarily unlocking a LockBatch with " << size() << " keys";
+  DCHECK_NOTNULL(data_.shared_lock_manager)->Unlock(data_.key_to_type);
+  data_.unlocked = true;
+}
+
+Status LockBatch::Relock(CoarseTimePoint deadline) {
+  if (empty() || !data_.unlocked) {
+    return Status::OK();
+  }
+  data_.unlocked = false;
+  if (!data_.shared_lock_manager->Lock(&data_.key_to_type, deadline)) {
+    data_.shared_lock_manager = nullptr;
+    data_.key_to_type.clear();
+    data_.status = STATUS_FORMAT(
+        TryAgain, "Failed to obtain locks until deadline: $0", deadline);
+    return data_.status;
+  }
+  return Status::OK();
+}
+
 void LockBatch::MoveFrom(LockBatch* other) {
   Reset();
   data_ = std::move(other->data_);
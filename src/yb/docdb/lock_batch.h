@@ -74,6 +74,13 @@ class LockBatch {
   // Unlocks this batch if it is non-empty.
   void Reset();
 
+  // Temporarily releases locks of this batch, keeping its keys, so they could be locked again
+  // with Relock. Used to avoid holding locks while waiting for conflicting transactions.
+  void Unlock();
+
+  // Locks keys released by Unlock again. On failure the batch becomes empty.
+  CHECKED_STATUS Relock(CoarseTimePoint deadline);
+
  private:
   void MoveFrom(LockBatch* other);
 
@@ -92,6 +99,9 @@ class LockBatch {
 
     SharedLockManager* shared_lock_manager = nullptr;
 
+    // Whether locks were temporarily released by Unlock.
+    bool unlocked = false;
+
     Status status;
   };
 
@@ -0,0 +1,135 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/pgsql_filter.h"
+
+#include <boost/optional/optional_io.hpp>
+
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr ColumnIdRep kColumn1 = 11;
+constexpr ColumnIdRep kColumn2 = 12;
+
+PgsqlConditionPB* AddCondition(PgsqlConditionPB* parent, QLOperator op) {
+  auto* condition = parent->add_operands()->mutable_condition();
+  condition->set_op(op);
+  return condition;
+}
+
+void AddColumn(PgsqlConditionPB* condition, ColumnIdRep column_id) {
+  condition->add_operands()->set_column_id(column_id);
+}
+
+void AddInt32(PgsqlConditionPB* condition, int32_t value) {
+  condition->add_operands()->mutable_value()->set_int32_value(value);
+}
+
+QLTableRow MakeRow(boost::optional<int32_t> value1, int32_t value2) {
+  QLTableRow row;
+  auto& column1 = row.AllocColumn(kColumn1);
+  if (value1) {
+    column1.value.set_int32_value(*value1);
+  }
+  row.AllocColumn(kColumn2).value.set_int32_value(value2);
+  return row;
+}
+
+} // namespace
+
+class PgsqlFilterTest : public YBTest {
+ protected:
+  // Checks that compiled filter gives the same result as the expression executor, when it decides
+  // the row.
+  void CheckRow(const QLTableRow& row, boost::optional<bool> expected) {
+    auto result = filter_.Matches(row);
+    ASSERT_EQ(expected, result);
+    if (result) {
+      QLExprExecutor executor;
+      bool executor_result = false;
+      ASSERT_OK(executor.EvalCondition(where_expr_.condition(), row, &executor_result));
+      ASSERT_EQ(executor_result, *result);
+    }
+  }
+
+  PgsqlExpressionPB where_expr_;
+  CompiledPgsqlFilter filter_;
+};
+
+TEST_F(PgsqlFilterTest, Conjunction) {
+  // c1 > 10 AND 20 >= c1 AND c2 IN (1, 3, 5)
+  auto* and_condition = where_expr_.mutable_condition();
+  and_condition->set_op(QL_OP_AND);
+  auto* condition = AddCondition(and_condition, QL_OP_GREATER_THAN);
+  AddColumn(condition, kColumn1);
+  AddInt32(condition, 10);
+  condition = AddCondition(and_condition, QL_OP_GREATER_THAN_EQUAL);
+  AddInt32(condition, 20);
+  AddColumn(condition, kColumn1);
+  condition = AddCondition(and_condition, QL_OP_IN);
+  AddColumn(condition, kColumn2);
+  auto* list = condition->add_operands()->mutable_value()->mutable_list_value();
+  for (int32_t value : {5, 1, 3}) {
+    list->add_elems()->set_int32_value(value);
+  }
+
+  ASSERT_TRUE(filter_.Compile(where_expr_));
+  ASSERT_EQ(3, filter_.num_terms());
+
+  ASSERT_NO_FATALS(CheckRow(MakeRow(15, 3), true));
+  ASSERT_NO_FATALS(CheckRow(MakeRow(20, 5), true));
+  ASSERT_NO_FATALS(CheckRow(MakeRow(10, 3), false));
+  ASSERT_NO_FATALS(CheckRow(MakeRow(21, 3), false));
+  ASSERT_NO_FATALS(CheckRow(MakeRow(15, 4), false));
+  // NULL is left to the expression executor.
+  ASSERT_NO_FATALS(CheckRow(MakeRow(boost::none, 3), boost::none));
+}
+
+TEST_F(PgsqlFilterTest, Between) {
+  auto* condition = where_expr_.mutable_condition();
+  condition->set_op(QL_OP_BETWEEN);
+  AddColumn(condition, kColumn2);
+  AddInt32(condition, -5);
+  AddInt32(condition, 5);
+
+  ASSERT_TRUE(filter_.Compile(where_expr_));
+  ASSERT_NO_FATALS(CheckRow(MakeRow(0, -5), true));
+  ASSERT_NO_FATALS(CheckRow(MakeRow(0, 5), true));
+  ASSERT_NO_FATALS(CheckRow(MakeRow(0, 6), false));
+}
+
+TEST_F(PgsqlFilterTest, NotCompiled) {
+  // OR is not supported.
+  auto* or_condition = where_expr_.mutable_condition();
+  or_condition->set_op(QL_OP_OR);
+  auto* condition = AddCondition(or_condition, QL_OP_EQUAL);
+  AddColumn(condition, kColumn1);
+  AddInt32(condition, 1);
+  ASSERT_FALSE(filter_.Compile(where_expr_));
+
+  // Comparison of two columns is not supported.
+  or_condition->set_op(QL_OP_AND);
+  condition = AddCondition(or_condition, QL_OP_EQUAL);
+  AddColumn(condition, kColumn1);
+  AddColumn(condition, kColumn2);
+  ASSERT_FALSE(filter_.Compile(where_expr_));
+  ASSERT_EQ(0, filter_.num_terms());
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,202 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/pgsql_filter.h"
+
+#include <algorithm>
+
+#include "yb/gutil/macros.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+bool GetIntegerValue(const QLValuePB& value, int64_t* out) {
+  switch (value.value_case()) {
+    case InternalType::kInt8Value:
+      *out = value.int8_value();
+      return true;
+    case InternalType::kInt16Value:
+      *out = value.int16_value();
+      return true;
+    case InternalType::kInt32Value:
+      *out = value.int32_value();
+      return true;
+    case InternalType::kInt64Value:
+      *out = value.int64_value();
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsColumnRef(const PgsqlExpressionPB& expr) {
+  // System columns, such as ybctid, are not stored in the row.
+  return expr.has_column_id() && expr.column_id() >= 0;
+}
+
+// Returns operator that gives the same result when operands are swapped.
+QLOperator SwapOperands(QLOperator op) {
+  switch (op) {
+    case QL_OP_LESS_THAN: return QL_OP_GREATER_THAN;
+    case QL_OP_LESS_THAN_EQUAL: return QL_OP_GREATER_THAN_EQUAL;
+    case QL_OP_GREATER_THAN: return QL_OP_LESS_THAN;
+    case QL_OP_GREATER_THAN_EQUAL: return QL_OP_LESS_THAN_EQUAL;
+    default: return op;
+  }
+}
+
+} // namespace
+
+bool CompiledPgsqlFilter::Compile(const PgsqlExpressionPB& where_expr) {
+  terms_.clear();
+  if (!where_expr.has_condition()) {
+    return false;
+  }
+  const auto& condition = where_expr.condition();
+  if (condition.op() != QL_OP_AND) {
+    return CompileTerm(condition);
+  }
+  if (condition.operands().empty()) {
+    return false;
+  }
+  for (const auto& operand : condition.operands()) {
+    if (!operand.has_condition() || !CompileTerm(operand.condition())) {
+      terms_.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CompiledPgsqlFilter::CompileTerm(const PgsqlConditionPB& condition) {
+  const auto& operands = condition.operands();
+  Term term;
+  term.op = condition.op();
+  switch (condition.op()) {
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: {
+      if (operands.size() != 2) {
+        return false;
+      }
+      const PgsqlExpressionPB* column = &operands.Get(0);
+      const PgsqlExpressionPB* constant = &operands.Get(1);
+      if (!IsColumnRef(*column)) {
+        std::swap(column, constant);
+        term.op = SwapOperands(term.op);
+      }
+      if (!IsColumnRef(*column) || !constant->has_value() ||
+          !GetIntegerValue(constant->value(), &term.value)) {
+        return false;
+      }
+      term.column_id = column->column_id();
+      term.value_case = constant->value().value_case();
+      break;
+    }
+
+    case QL_OP_BETWEEN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_BETWEEN: {
+      if (operands.size() != 3 || !IsColumnRef(operands.Get(0)) ||
+          !operands.Get(1).has_value() || !operands.Get(2).has_value()) {
+        return false;
+      }
+      const auto& lower = operands.Get(1).value();
+      const auto& upper = operands.Get(2).value();
+      if (lower.value_case() != upper.value_case() ||
+          !GetIntegerValue(lower, &term.value) || !GetIntegerValue(upper, &term.upper_value)) {
+        return false;
+      }
+      term.column_id = operands.Get(0).column_id();
+      term.value_case = lower.value_case();
+      break;
+    }
+
+    case QL_OP_IN: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_IN: {
+      if (operands.size() != 2 || !IsColumnRef(operands.Get(0)) ||
+          !operands.Get(1).has_value() || !operands.Get(1).value().has_list_value()) {
+        return false;
+      }
+      const auto& elems = operands.Get(1).value().list_value().elems();
+      if (elems.empty()) {
+        return false;
+      }
+      term.value_case = elems.Get(0).value_case();
+      term.in_values.reserve(elems.size());
+      for (const auto& elem : elems) {
+        int64_t value;
+        if (elem.value_case() != term.value_case || !GetIntegerValue(elem, &value)) {
+          return false;
+        }
+        term.in_values.push_back(value);
+      }
+      std::sort(term.in_values.begin(), term.in_values.end());
+      term.column_id = operands.Get(0).column_id();
+      break;
+    }
+
+    default:
+      return false;
+  }
+  terms_.push_back(std::move(term));
+  return true;
+}
+
+boost::optional<bool> CompiledPgsqlFilter::Matches(const QLTableRow& table_row) const {
+  // Terms are checked in the same order as the expression executor checks operands of AND,
+  // so a row is decided by the filter only when the executor would not reach an undecided term.
+  for (const auto& term : terms_) {
+    const QLValuePB* value = table_row.GetColumn(term.column_id);
+    if (value == nullptr) {
+      return boost::none;
+    }
+    auto term_result = MatchTerm(term, *value);
+    if (!term_result || !*term_result) {
+      return term_result;
+    }
+  }
+  return true;
+}
+
+boost::optional<bool> CompiledPgsqlFilter::MatchTerm(const Term& term, const QLValuePB& value) {
+  // NULL and values of other types are not comparable with constants in the same way, so they
+  // are left to the expression executor.
+  int64_t v;
+  if (value.value_case() != term.value_case || !GetIntegerValue(value, &v)) {
+    return boost::none;
+  }
+  switch (term.op) {
+    case QL_OP_EQUAL: return v == term.value;
+    case QL_OP_NOT_EQUAL: return v != term.value;
+    case QL_OP_LESS_THAN: return v < term.value;
+    case QL_OP_LESS_THAN_EQUAL: return v <= term.value;
+    case QL_OP_GREATER_THAN: return v > term.value;
+    case QL_OP_GREATER_THAN_EQUAL: return v >= term.value;
+    case QL_OP_BETWEEN: return v >= term.value && v <= term.upper_value;
+    case QL_OP_NOT_BETWEEN: return !(v >= term.value && v <= term.upper_value);
+    case QL_OP_IN:
+      return std::binary_search(term.in_values.begin(), term.in_values.end(), v);
+    case QL_OP_NOT_IN:
+      return !std::binary_search(term.in_values.begin(), term.in_values.end(), v);
+    default:
+      return boost::none;
+  }
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,73 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_PGSQL_FILTER_H
+#define YB_DOCDB_PGSQL_FILTER_H
+
+#include <vector>
+
+#include <boost/optional.hpp>
+
+#include "yb/common/pgsql_protocol.pb.h"
+#include "yb/common/ql_expr.h"
+
+namespace yb {
+namespace docdb {
+
+// Filter compiled from the where condition of a YSQL read request.
+//
+// Evaluating a condition with QLExprExecutor walks the expression tree and materializes
+// intermediate QLValues for every row. Most pushed down conditions are a conjunction of simple
+// comparisons between an integer column and constants, so such conditions are compiled once per
+// request into a flat list of terms that are checked against the column values in place.
+//
+// The compiled filter only decides rows that it could evaluate with exactly the same result as
+// the expression executor. Rows with NULL or unexpectedly typed values are left to the executor.
+class CompiledPgsqlFilter {
+ public:
+  // Tries to compile the condition. Returns false if condition contains anything besides a
+  // conjunction of supported comparisons, in which case the filter should not be used.
+  bool Compile(const PgsqlExpressionPB& where_expr);
+
+  // Returns whether row matches the condition, or boost::none if the row could not be decided by
+  // the compiled filter and should be evaluated by the expression executor.
+  boost::optional<bool> Matches(const QLTableRow& table_row) const;
+
+  size_t num_terms() const {
+    return terms_.size();
+  }
+
+ private:
+  struct Term {
+    ColumnIdRep column_id = 0;
+    QLOperator op = QL_OP_NOOP;
+    // Value case of the constants, column value should have the same case to be comparable.
+    InternalType value_case = InternalType::VALUE_NOT_SET;
+    int64_t value = 0;
+    // Upper bound for QL_OP_BETWEEN, the lower bound is stored in value.
+    int64_t upper_value = 0;
+    // Sorted values for QL_OP_IN.
+    std::vector<int64_t> in_values;
+  };
+
+  bool CompileTerm(const PgsqlConditionPB& condition);
+
+  static boost::optional<bool> MatchTerm(const Term& term, const QLValuePB& value);
+
+  std::vector<Term> terms_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif // YB_DOCDB_PGSQL_FILTER_H
@@ -13,7 +13,12 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <numeric>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -34,6 +39,7 @@
 
 #include "yb/util/flag_tags.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/threadpool.h"
 #include "yb/util/trace.h"
 
 #include "yb/yql/pggate/util/pg_doc_data.h"
@@ -667,16 +673,149 @@ Result<size_t> PgsqlReadOperation::Execute(const common::YQLStorageIf& ql_storag
     fetched_rows = VERIFY_RESULT(ExecuteBatchYbctid(
         ql_storage, deadline, read_time, schema,
         request_.unknown_ybctid_allowed(), result_buffer, restart_read_ht));
+    *restart_read_ht = table_iter_->RestartReadHt();
+  } else if (parallel_scan_.pool && !parallel_scan_.split_keys.empty() &&
+             IsParallelScanSupported(request_, schema)) {
+    fetched_rows = VERIFY_RESULT(ExecuteParallel(
+        ql_storage, deadline, read_time, is_explicit_request_read_time, schema, result_buffer,
+        restart_read_ht, &has_paging_state));
   } else {
     fetched_rows = VERIFY_RESULT(ExecuteScalar(
         ql_storage, deadline, read_time, is_explicit_request_read_time, schema, index_schema,
         result_buffer, restart_read_ht, &has_paging_state));
+    *restart_read_ht = table_iter_->RestartReadHt();
   }
 
   if (FLAGS_trace_docdb_calls) {
     TRACE("Fetched $0 rows. $1 paging state", fetched_rows, (has_paging_state ? "No" : "Has"));
   }
-  *restart_read_ht = table_iter_->RestartReadHt();
+  return fetched_rows;
+}
+
+bool PgsqlReadOperation::IsParallelScanSupported(
+    const PgsqlReadRequestPB& request, const Schema& schema) {
+  return request.is_aggregate() && request.is_forward_scan() && !request.has_index_request() &&
+         !request.has_ybctid_column_value() && request.batch_arguments().empty() &&
+         request.partition_column_values().empty() && request.range_column_values().empty() &&
+         !request.has_condition_expr() && !schema.has_cotable_id() && !schema.has_pgtable_id();
+}
+
+Result<size_t> PgsqlReadOperation::ExecuteParallel(const common::YQLStorageIf& ql_storage,
+                                                   CoarseTimePoint deadline,
+                                                   const ReadHybridTime& read_time,
+                                                   bool is_explicit_request_read_time,
+                                                   const Schema& schema,
+                                                   faststring *result_buffer,
+                                                   HybridTime *restart_read_ht,
+                                                   bool *has_paging_state) {
+  struct KeyRangeScan {
+    std::unique_ptr<PgsqlReadOperation> op;
+    faststring result_buffer;
+    HybridTime restart_read_ht;
+    bool has_paging_state = false;
+    bool executed = false;
+    Result<size_t> fetched_rows = static_cast<size_t>(0);
+  };
+
+  // Key ranges are claimed in key order by the calling thread and by pool tasks. Tasks could start
+  // after this function returns, so they hold the state by shared pointer.
+  struct ParallelScanState {
+    std::vector<KeyRangeScan> scans;
+    std::function<void(KeyRangeScan*)> execute;
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t next_scan = 0;
+    // Number of key ranges that are being scanned now.
+    size_t running = 0;
+    // Set when no more key ranges should be claimed.
+    bool stopped = false;
+  };
+
+  const auto& split_keys = parallel_scan_.split_keys;
+  auto state = std::make_shared<ParallelScanState>();
+  state->scans.resize(split_keys.size() + 1);
+  for (size_t i = 0; i != state->scans.size(); ++i) {
+    auto& scan = state->scans[i];
+    scan.op = std::make_unique<PgsqlReadOperation>(request_, txn_op_context_);
+    if (i > 0) {
+      scan.op->scan_range_start_ = split_keys[i - 1];
+    }
+    if (i < split_keys.size()) {
+      scan.op->scan_range_end_ = split_keys[i];
+    }
+  }
+
+  // Invoked only for claimed key ranges, and this function waits for all of them to complete,
+  // so references to its arguments stay valid.
+  state->execute = [&](KeyRangeScan* scan) {
+    scan->fetched_rows = scan->op->ExecuteScalar(
+        ql_storage, deadline, read_time, is_explicit_request_read_time, schema,
+        nullptr /* index_schema */, &scan->result_buffer, &scan->restart_read_ht,
+        &scan->has_paging_state);
+    if (scan->fetched_rows.ok()) {
+      scan->restart_read_ht = scan->op->table_iter_->RestartReadHt();
+    }
+  };
+
+  // Scans key ranges until all of them are claimed. Rows after a key range that was not scanned
+  // completely are read by the next page, so following key ranges are not claimed after that.
+  auto run = [](const std::shared_ptr<ParallelScanState>& state) {
+    for (;;) {
+      KeyRangeScan* scan;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->stopped || state->next_scan == state->scans.size()) {
+          return;
+        }
+        scan = &state->scans[state->next_scan++];
+        ++state->running;
+      }
+      state->execute(scan);
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        scan->executed = true;
+        if (scan->has_paging_state || !scan->fetched_rows.ok()) {
+          state->stopped = true;
+        }
+        --state->running;
+      }
+      state->cond.notify_all();
+    }
+  };
+
+  // The calling thread scans key ranges as well, so it does not wait for tasks that are queued
+  // in the pool, only for key ranges that pool threads are scanning.
+  for (size_t i = 1; i != state->scans.size(); ++i) {
+    if (!parallel_scan_.pool->SubmitFunc([run, state] { run(state); }).ok()) {
+      break;
+    }
+  }
+  run(state);
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->stopped = true;
+    state->cond.wait(lock, [&state] { return state->running == 0; });
+  }
+
+  // Key ranges after the first one that has not been scanned completely are dropped, so the next
+  // page starts from the paging state of that key range.
+  size_t fetched_rows = 0;
+  *has_paging_state = false;
+  *restart_read_ht = HybridTime::kInvalid;
+  for (auto& scan : state->scans) {
+    SCHECK(scan.executed, IllegalState, "Key range was not scanned");
+    fetched_rows += VERIFY_RESULT(std::move(scan.fetched_rows));
+    result_buffer->append(scan.result_buffer.data(), scan.result_buffer.size());
+    if (scan.restart_read_ht.is_valid() &&
+        (!restart_read_ht->is_valid() || scan.restart_read_ht > *restart_read_ht)) {
+      *restart_read_ht = scan.restart_read_ht;
+    }
+    if (scan.has_paging_state) {
+      response_.mutable_paging_state()->Swap(scan.op->response_.mutable_paging_state());
+      *has_paging_state = true;
+      break;
+    }
+  }
   return fetched_rows;
 }
 
@@ -713,6 +852,12 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
   table_iter_ = VERIFY_RESULT(CreateIterator(
       ql_storage, request_, projection, schema, txn_op_context_,
       deadline, read_time, is_explicit_request_read_time));
+  // The scan bounds of the request are applied by the iterator, so it is moved to the start of the
+  // scanned key range only when that range starts after the first row within the bounds.
+  if (!scan_range_start_.empty() && VERIFY_RESULT(table_iter_->HasNext()) &&
+      VERIFY_RESULT(table_iter_->GetTupleId()).compare(scan_range_start_) < 0) {
+    RETURN_NOT_OK(table_iter_->SeekTuple(scan_range_start_));
+  }
 
   ColumnId ybbasectid_id;
   if (request_.has_index_request()) {
@@ -740,9 +885,15 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
 
   // Fetching data.
   int match_count = 0;
+  bool scan_range_end_reached = false;
   QLTableRow row;
   while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
          !scan_time_exceeded) {
+    if (!scan_range_end_.empty() &&
+        VERIFY_RESULT(iter->GetTupleId()).compare(scan_range_end_) >= 0) {
+      scan_range_end_reached = true;
+      break;
+    }
     row.Clear();
 
     // If there is an index request, fetch ybbasectid from the index and use it as ybctid
@@ -762,14 +913,8 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
       RETURN_NOT_OK(iter->NextRow(projection, &row));
     }
 
-    // Match the row with the where condition before adding to the row block.
-    bool is_match = true;
-    if (request_.has_where_expr()) {
-      QLExprResult match;
-      RETURN_NOT_OK(EvalExpr(request_.where_expr(), row, match.Writer()));
-      is_match = match.Value().bool_value();
-    }
-    if (is_match) {
+    // Match the row with the conditions before adding to the row block.
+    if (VERIFY_RESULT(MatchesConditions(row))) {
       match_count++;
       if (request_.is_aggregate()) {
         RETURN_NOT_OK(EvalAggregate(row));
@@ -795,9 +940,12 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
     SleepFor(MonoDelta::FromMilliseconds(FLAGS_TEST_slowdown_pgsql_aggregate_read_ms));
   }
 
-  RETURN_NOT_OK(SetPagingStateIfNecessary(
-      iter, fetched_rows, row_count_limit, scan_time_exceeded, scan_schema,
-      read_time, has_paging_state));
+  // Rows after the end of the scanned key range are read by the scan of the next key range.
+  if (!scan_range_end_reached) {
+    RETURN_NOT_OK(SetPagingStateIfNecessary(
+        iter, fetched_rows, row_count_limit, scan_time_exceeded, scan_schema,
+        read_time, has_paging_state));
+  }
   return fetched_rows;
 }
 
@@ -811,16 +959,38 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const common::YQLStorageIf
   Schema projection;
   RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
 
-  QLTableRow row;
+  // All rows of the batch are read with the same iterator, looking them up in ascending ybctid
+  // order, so the iterator only moves forward and rocksdb iterators are created once per batch.
+  // A ybctid is the encoded doc key of the row, which starts with the hash code for hash
+  // partitioned tables, so its binary order is the order of rows in the tablet.
+  RETURN_NOT_OK(ql_storage.GetIterator(request_.stmt_id(), projection, schema, txn_op_context_,
+                                       deadline, read_time, &table_iter_));
+
+  const auto& batch_arguments = request_.batch_arguments();
+  auto ybctid = [&batch_arguments](int idx) -> Slice {
+    return batch_arguments.Get(idx).ybctid().value().binary_value();
+  };
+  auto ybctid_less = [&ybctid](int lhs, int rhs) {
+    return ybctid(lhs).compare(ybctid(rhs)) < 0;
+  };
+  std::vector<int> order(batch_arguments.size());
+  std::iota(order.begin(), order.end(), 0);
+  const bool sorted = std::is_sorted(order.begin(), order.end(), ybctid_less);
+  if (!sorted) {
+    std::stable_sort(order.begin(), order.end(), ybctid_less);
+  }
+
+  // Rows are returned in the order of batch arguments, so when the lookup order is different
+  // rows are kept until all of them are read.
+  std::vector<QLTableRow> rows(sorted ? 1 : order.size());
+  std::vector<bool> found(sorted ? 0 : order.size());
   size_t row_count = 0;
-  for (const PgsqlBatchArgumentPB& batch_argument : request_.batch_arguments()) {
+  for (int idx : order) {
     // Get the row.
-    RETURN_NOT_OK(ql_storage.GetIterator(request_.stmt_id(), projection, schema, txn_op_context_,
-                                         deadline, read_time, batch_argument.ybctid().value(),
-                                         &table_iter_));
+    auto& row = rows[sorted ? 0 : idx];
     row.Clear();
 
-    if (!VERIFY_RESULT(table_iter_->HasNext())) {
+    if (!VERIFY_RESULT(table_iter_->SeekTuple(ybctid(idx)))) {
       if (unknown_ybctid_allowed) {
         continue;
       } else {
@@ -829,11 +999,23 @@ Result<size_t> PgsqlReadOperation::ExecuteBatchYbctid(const common::YQLStorageIf
     }
     RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
 
-    // Populate result set.
-    RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+    if (sorted) {
+      // Populate result set.
+      RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+    } else {
+      found[idx] = true;
+    }
     row_count++;
   }
 
+  if (!sorted) {
+    for (size_t idx = 0; idx != rows.size(); ++idx) {
+      if (found[idx]) {
+        RETURN_NOT_OK(PopulateResultSet(rows[idx], result_buffer));
+      }
+    }
+  }
+
   // Set status for this batch.
   // Mark all rows were processed even in case some of the ybctids were not found.
   response_.set_batch_arg_count(request_.batch_arguments_size());
@@ -889,10 +1071,80 @@ Status PgsqlReadOperation::SetPagingStateIfNecessary(const common::YQLRowwiseIte
   return Status::OK();
 }
 
+void PgsqlReadOperation::CompileFilters() {
+  filters_compiled_ = true;
+  if (request_.has_condition_expr()) {
+    CompiledPgsqlFilter filter;
+    if (filter.Compile(request_.condition_expr())) {
+      condition_filter_ = std::move(filter);
+    }
+  }
+  if (request_.has_where_expr()) {
+    CompiledPgsqlFilter filter;
+    if (filter.Compile(request_.where_expr())) {
+      where_filter_ = std::move(filter);
+    }
+  }
+}
+
+Result<bool> PgsqlReadOperation::MatchesConditions(const QLTableRow& table_row) {
+  if (!filters_compiled_) {
+    CompileFilters();
+  }
+  if (request_.has_condition_expr()) {
+    // Scan bounds do not express every pushed down condition, so it is checked for each row.
+    boost::optional<bool> result;
+    if (condition_filter_) {
+      result = condition_filter_->Matches(table_row);
+    }
+    if (!result) {
+      QLExprResult match;
+      RETURN_NOT_OK(EvalExpr(request_.condition_expr(), table_row, match.Writer()));
+      result = match.Value().bool_value();
+    }
+    if (!*result) {
+      return false;
+    }
+  }
+  if (!request_.has_where_expr()) {
+    return true;
+  }
+  if (where_filter_) {
+    auto result = where_filter_->Matches(table_row);
+    if (result) {
+      return *result;
+    }
+  }
+  QLExprResult match;
+  RETURN_NOT_OK(EvalExpr(request_.where_expr(), table_row, match.Writer()));
+  return match.Value().bool_value();
+}
+
+void PgsqlReadOperation::ResolveTargetColumnRefs() {
+  target_column_refs_.clear();
+  target_column_refs_.reserve(request_.targets().size());
+  for (const PgsqlExpressionPB& expr : request_.targets()) {
+    // System columns, such as ybctid, have negative ids and are evaluated by EvalColumnRef.
+    target_column_refs_.push_back(
+        expr.has_column_id() && expr.column_id() >= 0 ? expr.column_id() : -1);
+  }
+}
+
 Status PgsqlReadOperation::PopulateResultSet(const QLTableRow& table_row,
                                              faststring *result_buffer) {
+  if (target_column_refs_.size() != request_.targets().size()) {
+    ResolveTargetColumnRefs();
+  }
   QLExprResult result;
+  size_t target_index = 0;
   for (const PgsqlExpressionPB& expr : request_.targets()) {
+    const ColumnIdRep column_ref = target_column_refs_[target_index++];
+    if (column_ref >= 0) {
+      const QLValuePB* value = table_row.GetColumn(column_ref);
+      RETURN_NOT_OK(pggate::WriteColumn(
+          value ? *value : QLValuePB::default_instance(), result_buffer));
+      continue;
+    }
     RETURN_NOT_OK(EvalExpr(expr, table_row, result.Writer()));
     RETURN_NOT_OK(pggate::WriteColumn(result.Value(), result_buffer));
   }
@@ -14,16 +14,21 @@
 #ifndef YB_DOCDB_PGSQL_OPERATION_H
 #define YB_DOCDB_PGSQL_OPERATION_H
 
+#include <string>
+#include <vector>
+
 #include "yb/common/ql_rowwise_iterator_interface.h"
 
 #include "yb/docdb/doc_expr.h"
 #include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_operation.h"
 #include "yb/docdb/intent_aware_iterator.h"
+#include "yb/docdb/pgsql_filter.h"
 
 namespace yb {
 
 class IndexInfo;
+class ThreadPool;
 
 namespace common {
 
@@ -35,6 +40,14 @@ namespace docdb {
 
 YB_STRONGLY_TYPED_BOOL(IsUpsert);
 
+// Parameters of a read that scans key ranges of the tablet in parallel.
+struct PgsqlParallelScan {
+  ThreadPool* pool = nullptr;
+
+  // Encoded doc keys, in ascending order, that split the tablet into the scanned key ranges.
+  std::vector<std::string> split_keys;
+};
+
 class PgsqlWriteOperation :
     public DocOperationBase<DocOperationType::PGSQL_WRITE_OPERATION, PgsqlWriteRequestPB>,
     public DocExprExecutor {
@@ -136,6 +149,16 @@ class PgsqlReadOperation : public DocExprExecutor {
   const PgsqlReadRequestPB& request() const { return request_; }
   PgsqlResponsePB& response() { return response_; }
 
+  // Whether the request could be executed by scanning key ranges of the tablet in parallel.
+  // Only forward scans of aggregates over whole non colocated tables are supported, because
+  // partial aggregates of key ranges are merged by the client.
+  static bool IsParallelScanSupported(const PgsqlReadRequestPB& request, const Schema& schema);
+
+  // Makes Execute scan key ranges between split keys in parallel, when the request is supported.
+  void SetParallelScan(PgsqlParallelScan parallel_scan) {
+    parallel_scan_ = std::move(parallel_scan);
+  }
+
   // Driver of the execution for READ operators for the given conditions in Protobuf request.
   // The protobuf request carries two different types of arguments.
   // - Scalar argument: The query condition is represented by one set of values. For example, each
@@ -172,6 +195,18 @@ class PgsqlReadOperation : public DocExprExecutor {
                                HybridTime *restart_read_ht,
                                bool *has_paging_state);
 
+  // Execute a READ operator by scanning key ranges between split keys of parallel_scan_ in
+  // parallel, each by a separate operation. Results of the key ranges are written to the result
+  // buffer in key order, up to the first key range that was not scanned completely.
+  Result<size_t> ExecuteParallel(const common::YQLStorageIf& ql_storage,
+                                 CoarseTimePoint deadline,
+                                 const ReadHybridTime& read_time,
+                                 bool is_explicit_request_read_time,
+                                 const Schema& schema,
+                                 faststring *result_buffer,
+                                 HybridTime *restart_read_ht,
+                                 bool *has_paging_state);
+
   // Execute a READ operator for a given batch of ybctids.
   Result<size_t> ExecuteBatchYbctid(const common::YQLStorageIf& ql_storage,
                                     CoarseTimePoint deadline,
@@ -184,6 +219,15 @@ class PgsqlReadOperation : public DocExprExecutor {
   CHECKED_STATUS PopulateResultSet(const QLTableRow& table_row,
                                    faststring *result_buffer);
 
+  // Fills target_column_refs_ for the targets of the request.
+  void ResolveTargetColumnRefs();
+
+  // Checks whether the row matches condition_expr and where_expr of the request.
+  Result<bool> MatchesConditions(const QLTableRow& table_row);
+
+  // Compiles condition_expr and where_expr of the request, when they could be compiled.
+  void CompileFilters();
+
   CHECKED_STATUS EvalAggregate(const QLTableRow& table_row);
 
   CHECKED_STATUS PopulateAggregate(const QLTableRow& table_row,
@@ -202,9 +246,29 @@ class PgsqlReadOperation : public DocExprExecutor {
   //------------------------------------------------------------------------------------------------
   const PgsqlReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
+  PgsqlParallelScan parallel_scan_;
+  // Key range of the tablet scanned by ExecuteScalar, as encoded doc keys. The start key is
+  // inclusive and the end key is exclusive, empty keys do not limit the scan.
+  std::string scan_range_start_;
+  std::string scan_range_end_;
   PgsqlResponsePB response_;
   common::YQLRowwiseIteratorIf::UniPtr table_iter_;
   common::YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // For each target of the request, contains id of the regular column that this target refers to,
+  // or a negative value when the target should be evaluated as an expression.
+  // It is resolved once per request, so the column values of each row are written to the result
+  // set directly, without going through the expression executor.
+  std::vector<ColumnIdRep> target_column_refs_;
+
+  // Conditions of the request compiled for evaluation without the expression executor.
+  // Set only when the condition could be compiled.
+  // condition_expr is used by the scan spec to bound the scanned keys, but the bounds do not
+  // express every pushed down condition, so it is also checked for each row, by the expression
+  // executor when the compiled filter is not set or could not decide the row.
+  boost::optional<CompiledPgsqlFilter> condition_filter_;
+  boost::optional<CompiledPgsqlFilter> where_filter_;
+  bool filters_compiled_ = false;
 };
 
 }  // namespace docdb
@@ -22,6 +22,7 @@
 
 #include "yb/rpc/thread_pool.h"
 
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 #include "yb/util/test_macros.h"
 #include "yb/util/test_util.h"
@@ -33,6 +34,12 @@ using std::vector;
 using std::stack;
 using std::thread;
 
+METRIC_DEFINE_entity(test_entity);
+METRIC_DEFINE_counter(test_entity, test_lock_waits, "Test Lock Waits",
+                      yb::MetricUnit::kRequests, "Test lock waits");
+METRIC_DEFINE_counter(test_entity, test_stripe_contentions, "Test Stripe Contentions",
+                      yb::MetricUnit::kRequests, "Test stripe contentions");
+
 namespace yb {
 namespace docdb {
 
@@ -184,5 +191,39 @@ TEST_F(SharedLockManagerTest, LockConflicts) {
   tp.Shutdown();
 }
 
+TEST_F(SharedLockManagerTest, LockWaitsMetric) {
+  scoped_refptr<Counter> lock_waits = new Counter(&METRIC_test_lock_waits);
+  scoped_refptr<Counter> stripe_contentions = new Counter(&METRIC_test_stripe_contentions);
+  lm_.SetMetrics(lock_waits, stripe_contentions);
+
+  const IntentTypeSet kStrongWrite({IntentType::kStrongWrite});
+  LockBatch lb1(&lm_, {{kKey1, kStrongWrite}}, CoarseTimePoint::max());
+  ASSERT_OK(lb1.status());
+  // Lock on other key does not wait.
+  {
+    LockBatch lb2(&lm_, {{kKey2, kStrongWrite}}, CoarseTimePoint::max());
+    ASSERT_OK(lb2.status());
+  }
+  ASSERT_EQ(0, lock_waits->value());
+
+  // Conflicting lock waits until deadline.
+  {
+    LockBatch lb2(&lm_, {{kKey1, kStrongWrite}}, CoarseMonoClock::now() + 10ms);
+    ASSERT_NOK(lb2.status());
+  }
+  ASSERT_EQ(1, lock_waits->value());
+
+  // Conflicting lock waits until first batch is released.
+  auto future = std::async(std::launch::async, [this, &kStrongWrite] {
+    LockBatch lb2(&lm_, {{kKey1, kStrongWrite}}, CoarseTimePoint::max());
+    return lb2.status();
+  });
+  std::this_thread::sleep_for(100ms);
+  ASSERT_EQ(std::future_status::timeout, future.wait_for(0s));
+  lb1.Reset();
+  ASSERT_OK(future.get());
+  ASSERT_EQ(2, lock_waits->value());
+}
+
 } // namespace docdb
 } // namespace yb
@@ -13,20 +13,28 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <algorithm>
 #include <vector>
 
 #include <boost/range/adaptor/reversed.hpp>
+#include <gflags/gflags.h>
 #include <glog/logging.h>
 
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/tostring.h"
 #include "yb/util/trace.h"
 
 using std::string;
 
+DEFINE_int32(shared_lock_manager_num_stripes, 32,
+             "Number of stripes in the lock table of the shared lock manager of each tablet. Keys "
+             "are distributed among stripes by hash, so batches locking different keys do not "
+             "serialize on a single mutex.");
+
 namespace yb {
 namespace docdb {
 
@@ -101,14 +109,20 @@ bool IntentTypeSetsConflict(IntentTypeSet lhs, IntentTypeSet rhs) {
   return false;
 }
 
+struct LockStripe;
+
 struct LockedBatchEntry {
+  explicit LockedBatchEntry(LockStripe* stripe_) : stripe(stripe_) {}
+
+  // Stripe of the lock manager that owns this entry.
+  LockStripe* const stripe;
+
   // Taken only for short duration, with no blocking wait.
   mutable std::mutex mutex;
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the stripe is locked.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -116,7 +130,8 @@ struct LockedBatchEntry {
 
   std::atomic<size_t> num_waiters{0};
 
-  MUST_USE_RESULT bool Lock(IntentTypeSet lock, CoarseTimePoint deadline);
+  // Sets *waited to true if lock could not be acquired immediately because of a conflict.
+  MUST_USE_RESULT bool Lock(IntentTypeSet lock, CoarseTimePoint deadline, bool* waited);
 
   void Unlock(IntentTypeSet lock);
 
@@ -128,34 +143,56 @@ struct LockedBatchEntry {
   }
 };
 
+// Part of the lock table, responsible for keys with the same hash modulo number of stripes.
+struct LockStripe {
+  typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
+
+  // Taken only for very short duration, with no blocking wait.
+  std::mutex mutex;
+
+  LockEntryMap locks GUARDED_BY(mutex);
+  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+  std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+};
+
 class SharedLockManager::Impl {
  public:
+  Impl() : stripes_(std::max(FLAGS_shared_lock_manager_num_stripes, 1)) {}
+
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  void SetMetrics(scoped_refptr<Counter> lock_waits, scoped_refptr<Counter> stripe_contentions) {
+    lock_waits_ = std::move(lock_waits);
+    stripe_contentions_ = std::move(stripe_contentions);
+  }
+
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& stripe : stripes_) {
+      std::lock_guard<std::mutex> lock(stripe.mutex);
+      LOG_IF(DFATAL, !stripe.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(stripe.locks);
+    }
   }
 
  private:
-  typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
-
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // Make sure the entries exist in the lock table and return pointers so we can access
+  // them without holding the stripe locks. Pointers are stored to locked field of the batch
+  // entries.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  // Locks mutex of the stripe, counting the cases when it was held by another thread.
+  std::unique_lock<std::mutex> LockStripeMutex(LockStripe* stripe);
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  std::vector<LockStripe> stripes_;
+
+  // Set once before the lock manager is used, so could be read without synchronization.
+  scoped_refptr<Counter> lock_waits_;
+  scoped_refptr<Counter> stripe_contentions_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -180,7 +217,7 @@ std::string SharedLockManager::ToString(const LockState& state) {
   return result;
 }
 
-bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
+bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline, bool* waited) {
   size_t type_idx = lock_type.ToUIntPtr();
   auto& num_holding = this->num_holding;
   auto old_value = num_holding.load(std::memory_order_acquire);
@@ -193,6 +230,7 @@ bool LockedBatchEntry::Lock(IntentTypeSet lock_type, CoarseTimePoint deadline) {
       }
       continue;
     }
+    *waited = true;
     num_waiters.fetch_add(1, std::memory_order_release);
     auto se = ScopeExit([this] {
       num_waiters.fetch_sub(1, std::memory_order_release);
@@ -254,12 +292,18 @@ void LockedBatchEntry::Unlock(IntentTypeSet lock_types) {
 bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline) {
   TRACE("Locking a batch of $0 keys", key_to_intent_type->size());
   Reserve(key_to_intent_type);
+  bool waited = false;
+  auto se = ScopeExit([this, &waited] {
+    if (waited && lock_waits_) {
+      lock_waits_->Increment();
+    }
+  });
   for (auto it = key_to_intent_type->begin(); it != key_to_intent_type->end(); ++it) {
     const auto& key_and_intent_type = *it;
     const auto intent_types = key_and_intent_type.intent_types;
     VLOG(4) << "Locking " << yb::ToString(intent_types) << ": "
             << key_and_intent_type.key.as_slice().ToDebugHexString();
-    if (!key_and_intent_type.locked->Lock(intent_types, deadline)) {
+    if (!key_and_intent_type.locked->Lock(intent_types, deadline, &waited)) {
       while (it != key_to_intent_type->begin()) {
         --it;
         it->locked->Unlock(it->intent_types);
@@ -273,17 +317,31 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
   return true;
 }
 
+std::unique_lock<std::mutex> SharedLockManager::Impl::LockStripeMutex(LockStripe* stripe) {
+  std::unique_lock<std::mutex> lock(stripe->mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    if (stripe_contentions_) {
+      stripe_contentions_->Increment();
+    }
+    lock.lock();
+  }
+  return lock;
+}
+
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
+  // Batches are small, so stripe mutex is taken separately for each key. Keys of the same batch
+  // are never locked while holding a stripe mutex, so there is no lock order issue.
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& stripe = stripes_[RefCntPrefixHash()(key_and_intent_type.key) % stripes_.size()];
+    auto lock = LockStripeMutex(&stripe);
+    auto& value = stripe.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!stripe.free_lock_entries.empty()) {
+        value = stripe.free_lock_entries.back();
+        stripe.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        stripe.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>(&stripe));
+        value = stripe.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -302,11 +360,12 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& item : key_to_intent_type) {
+    auto& stripe = *item.locked->stripe;
+    auto lock = LockStripeMutex(&stripe);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      stripe.locks.erase(item.key);
+      stripe.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -324,5 +383,10 @@ void SharedLockManager::Unlock(const LockBatchEntries& key_to_intent_type) {
   impl_->Unlock(key_to_intent_type);
 }
 
+void SharedLockManager::SetMetrics(
+    scoped_refptr<Counter> lock_waits, scoped_refptr<Counter> stripe_contentions) {
+  impl_->SetMetrics(std::move(lock_waits), std::move(stripe_contentions));
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -22,10 +22,14 @@
 
 #include "yb/docdb/shared_lock_manager_fwd.h"
 #include "yb/docdb/lock_batch.h"
+#include "yb/gutil/ref_counted.h"
 #include "yb/gutil/spinlock.h"
 #include "yb/util/cross_thread_mutex.h"
 
 namespace yb {
+
+class Counter;
+
 namespace docdb {
 
 // This class manages six types of locks on string keys. On each key, the possibilities are:
@@ -49,6 +53,11 @@ class SharedLockManager {
   // Release the batch of locks. Requires that the locks are held.
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  // Sets counters for lock contention. lock_waits is incremented for each batch that had to wait
+  // for a conflicting lock, stripe_contentions for each time mutex of a lock table stripe was
+  // busy. Should be called before the lock manager is used.
+  void SetMetrics(scoped_refptr<Counter> lock_waits, scoped_refptr<Counter> stripe_contentions);
+
   // Whether or not the state is possible
   static std::string ToString(const LockState& state);
 
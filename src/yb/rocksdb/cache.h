@@ -66,6 +66,13 @@ extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits);
 extern shared_ptr<Cache> NewLRUCache(size_t capacity, int num_shard_bits,
                                      bool strict_capacity_limit);
 
+// Create a new cache that uses CLOCK replacement instead of LRU, so cache hits do not need an
+// exclusive lock, and admits new entries by their estimated access frequency (TinyLFU), so
+// blocks read once, e.g. by a large scan, do not evict frequently used blocks.
+// Sharding and capacity semantics are the same as for NewLRUCache.
+extern shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                       bool strict_capacity_limit = false);
+
 using QueryId = int64_t;
 // Query ids to represent values for the default query id.
 constexpr QueryId kDefaultQueryId = 0;
@@ -28,6 +28,7 @@
 #include <string>
 #include <vector>
 
+#include "yb/util/result.h"
 #include "yb/util/slice.h"
 #include "yb/rocksdb/metadata.h"
 
@@ -162,6 +163,14 @@ class CompactionFilterFactory {
   virtual std::unique_ptr<CompactionFilter> CreateCompactionFilter(
       const CompactionFilter::Context& context) = 0;
 
+  // Returns the prefix of the user key that should be used as a boundary between subcompactions.
+  // Each subcompaction runs its own compaction filter, so filters that keep state across related
+  // keys could make sure that such keys are not split between subcompactions.
+  // The whole key is used by default.
+  virtual yb::Result<Slice> GetSubcompactionBoundary(Slice user_key) {
+    return user_key;
+  }
+
   // Returns a name that identifies this compaction filter factory.
   virtual const char* Name() const = 0;
 };
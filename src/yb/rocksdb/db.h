@@ -905,6 +905,9 @@ class DB {
   // Returns approximate middle key (see Version::GetMiddleKey).
   virtual yb::Result<std::string> GetMiddleKey() = 0;
 
+  // Returns approximate split keys of the DB into num_parts ranges (see Version::GetSplitKeys).
+  virtual yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) = 0;
+
   // Used in testing to make the old memtable immutable and start writing to a new one.
   virtual void TEST_SwitchMemtable() {}
 
@@ -544,7 +544,9 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
-    return number_levels_ > 1 && output_level_ > 0;
+    // With a single level, outputs of all subcompactions form a single sorted run in level 0,
+    // see IsSameLevel0SortedRun.
+    return number_levels_ == 1 || output_level_ > 0;
   } else {
     return false;
   }
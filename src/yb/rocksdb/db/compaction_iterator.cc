@@ -75,7 +75,10 @@ void CompactionIterator::SeekToFirst() {
   if (compaction_filter_) {
     auto drop_keys_before = compaction_filter_->DropKeysLessThan();
 
-    if (!drop_keys_before.empty()) {
+    // Input is already positioned at the start of the compaction, that could be after
+    // drop_keys_before when compaction is split into subcompactions.
+    if (!drop_keys_before.empty() && input_->Valid() &&
+        cmp_->Compare(ExtractUserKey(input_->key()), drop_keys_before) < 0) {
       IterKey start_iter;
       start_iter.SetInternalKey(drop_keys_before, kMaxSequenceNumber, kValueTypeForSeek);
       input_->Seek(start_iter.GetKey());
@@ -29,6 +29,8 @@
 
 #include <inttypes.h>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <vector>
 #include <memory>
@@ -37,6 +39,8 @@
 #include <thread>
 #include <utility>
 
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/db/builder.h"
 #include "yb/rocksdb/db/db_iter.h"
 #include "yb/rocksdb/db/dbformat.h"
@@ -72,11 +76,28 @@
 #include "yb/rocksdb/util/sync_point.h"
 #include "yb/rocksdb/util/thread_status_util.h"
 
+#include "yb/util/priority_thread_pool.h"
 #include "yb/util/stats/iostats_context_imp.h"
 #include "yb/util/string_util.h"
 
+DEFINE_uint64(min_subcompaction_size_bytes, 1ULL << 30,
+              "Minimal amount of input data per subcompaction, when compaction output is not "
+              "limited by the max file size, i.e. for universal compaction.");
+
+DECLARE_bool(allow_preempting_compactions);
+
 namespace rocksdb {
 
+namespace {
+
+// Number of split keys sampled from each level 0 input file per subcompaction.
+constexpr size_t kLevel0SplitKeysPerSubcompaction = 4;
+
+// How often the thread pool worker checks whether to pause while waiting for other subcompactions.
+constexpr auto kSubcompactionPauseCheckInterval = std::chrono::milliseconds(100);
+
+} // namespace
+
 // Maintains state for each sub-compaction
 struct CompactionJob::SubcompactionState {
   Compaction* compaction;
@@ -213,6 +234,61 @@ struct CompactionJob::CompactionState {
   }
 };
 
+// The thread pool suspender could be invoked only by the worker thread that runs the compaction,
+// while other subcompactions run on their own threads. So the worker pauses through the original
+// suspender, and other subcompactions wait while the worker is paused.
+class CompactionJob::SubcompactionSuspender : public yb::PriorityThreadPoolSuspender {
+ public:
+  explicit SubcompactionSuspender(yb::PriorityThreadPoolSuspender* worker_suspender)
+      : worker_suspender_(worker_suspender), worker_thread_id_(std::this_thread::get_id()) {}
+
+  void PauseIfNecessary() override {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (std::this_thread::get_id() != worker_thread_id_) {
+      cond_.wait(lock, [this] { return !worker_paused_; });
+      return;
+    }
+    worker_paused_ = true;
+    lock.unlock();
+    worker_suspender_->PauseIfNecessary();
+    lock.lock();
+    worker_paused_ = false;
+    cond_.notify_all();
+  }
+
+  void SubcompactionFinished() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++num_finished_;
+    cond_.notify_all();
+  }
+
+  // Invoked by the worker after its own subcompaction. Keeps pausing the worker when necessary
+  // until the other subcompactions are finished, since they cannot pause on their own.
+  void WaitSubcompactions(size_t num_subcompactions) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      if (cond_.wait_for(lock, kSubcompactionPauseCheckInterval, [this, num_subcompactions] {
+            return num_finished_ >= num_subcompactions;
+          })) {
+        return;
+      }
+      if (FLAGS_allow_preempting_compactions) {
+        lock.unlock();
+        PauseIfNecessary();
+        lock.lock();
+      }
+    }
+  }
+
+ private:
+  yb::PriorityThreadPoolSuspender* const worker_suspender_;
+  const std::thread::id worker_thread_id_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  bool worker_paused_ = false;
+  size_t num_finished_ = 0;
+};
+
 void CompactionJob::AggregateStatistics() {
   for (SubcompactionState& sc : compact_->sub_compact_states) {
     compact_->total_bytes += sc.total_bytes;
@@ -335,8 +411,23 @@ void CompactionJob::Prepare() {
   bottommost_level_ = c->bottommost_level();
 
   if (c->ShouldFormSubcompactions()) {
+    // Subcompaction boundaries are generated by Run, because input files are sampled for split
+    // keys and this I/O should not be done under the DB mutex. Until then the version is pinned.
+    subcompaction_input_version_ = c->column_family_data()->current();
+    subcompaction_input_version_->Ref();
+  }
+}
+
+void CompactionJob::PrepareSubcompactions() {
+  auto* c = compact_->compaction;
+  if (subcompaction_input_version_) {
     const uint64_t start_micros = env_->NowMicros();
-    GenSubcompactionBoundaries();
+    GenSubcompactionBoundaries(subcompaction_input_version_);
+    {
+      InstrumentedMutexLock l(db_mutex_);
+      subcompaction_input_version_->Unref();
+    }
+    subcompaction_input_version_ = nullptr;
     MeasureTime(stats_, SUBCOMPACTION_SETUP_TIME,
                 env_->NowMicros() - start_micros);
 
@@ -367,11 +458,12 @@ struct RangeWithSize {
 // to the working set and then finds the approximate size of data in between
 // each consecutive pair of slices. Then it divides these ranges into
 // consecutive groups such that each group has a similar size.
-void CompactionJob::GenSubcompactionBoundaries() {
+void CompactionJob::GenSubcompactionBoundaries(Version* v) {
   auto* c = compact_->compaction;
   auto* cfd = c->column_family_data();
   const Comparator* cfd_comparator = cfd->user_comparator();
   std::vector<Slice> bounds;
+  std::vector<std::string> sampled_keys;
   int start_lvl = c->start_level();
   int out_lvl = c->output_level();
 
@@ -394,6 +486,23 @@ void CompactionJob::GenSubcompactionBoundaries() {
           bounds.emplace_back(flevel->files[i].smallest.key);
           bounds.emplace_back(flevel->files[i].largest.key);
         }
+        // Level 0 files of universal compaction usually cover the whole key range, so the keys
+        // that split each file into parts of roughly the same size are also added.
+        for (const auto* file : *c->inputs(lvl_idx)) {
+          auto split_keys = v->GetSplitKeys(
+              *file, lvl, db_options_.max_subcompactions * kLevel0SplitKeysPerSubcompaction);
+          if (!split_keys.ok()) {
+            RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+                "[%s] [JOB %d] Failed to get split keys of file %" PRIu64 ": %s",
+                cfd->GetName().c_str(), job_id_, file->fd.GetNumber(),
+                split_keys.status().ToString().c_str());
+            continue;
+          }
+          for (const auto& user_key : *split_keys) {
+            sampled_keys.push_back(
+                InternalKey::MaxPossibleForUserKey(user_key).Encode().ToBuffer());
+          }
+        }
       } else {
         // For all other levels add the smallest/largest key in the level to
         // encompass the range covered by that level
@@ -412,6 +521,8 @@ void CompactionJob::GenSubcompactionBoundaries() {
     }
   }
 
+  bounds.insert(bounds.end(), sampled_keys.begin(), sampled_keys.end());
+
   std::sort(bounds.begin(), bounds.end(),
     [cfd_comparator] (const Slice& a, const Slice& b) -> bool {
       return cfd_comparator->Compare(ExtractUserKey(a), ExtractUserKey(b)) < 0;
@@ -426,7 +537,6 @@ void CompactionJob::GenSubcompactionBoundaries() {
   // size of data covered by keys in that range
   uint64_t sum = 0;
   std::vector<RangeWithSize> ranges;
-  auto* v = cfd->current();
   for (auto it = bounds.begin();;) {
     const Slice a = *it;
     it++;
@@ -443,9 +553,15 @@ void CompactionJob::GenSubcompactionBoundaries() {
 
   // Group the ranges into subcompactions
   const double min_file_fill_percent = 4.0 / 5;
-  uint64_t max_output_files = static_cast<uint64_t>(std::ceil(
-      sum / min_file_fill_percent /
-      cfd->GetCurrentMutableCFOptions()->MaxFileSizeForLevel(out_lvl)));
+  const uint64_t max_file_size = c->mutable_cf_options()->MaxFileSizeForLevel(out_lvl);
+  uint64_t max_output_files;
+  if (max_file_size == std::numeric_limits<uint64_t>::max()) {
+    // Output is not split by size, so just avoid too small subcompactions.
+    max_output_files = std::max<uint64_t>(sum / FLAGS_min_subcompaction_size_bytes, 1);
+  } else {
+    max_output_files = static_cast<uint64_t>(std::ceil(
+        sum / min_file_fill_percent / max_file_size));
+  }
   uint64_t subcompactions =
       std::min({static_cast<uint64_t>(ranges.size()),
                 static_cast<uint64_t>(db_options_.max_subcompactions),
@@ -455,6 +571,7 @@ void CompactionJob::GenSubcompactionBoundaries() {
                                     : std::numeric_limits<double>::max();
 
   if (subcompactions > 1) {
+    auto* compaction_filter_factory = cfd->ioptions()->compaction_filter_factory;
     // Greedily add ranges to the subcompaction until the sum of the ranges'
     // sizes becomes >= the expected mean size of a subcompaction
     sum = 0;
@@ -466,13 +583,31 @@ void CompactionJob::GenSubcompactionBoundaries() {
         continue;
       }
       if (sum >= mean) {
-        boundaries_.emplace_back(ExtractUserKey(ranges[i].range.limit));
+        Slice boundary = ExtractUserKey(ranges[i].range.limit);
+        if (compaction_filter_factory) {
+          auto filter_boundary = compaction_filter_factory->GetSubcompactionBoundary(boundary);
+          if (!filter_boundary.ok()) {
+            RLOG(InfoLogLevel::WARN_LEVEL, db_options_.info_log,
+                "[%s] [JOB %d] Failed to get subcompaction boundary: %s",
+                cfd->GetName().c_str(), job_id_, filter_boundary.status().ToString().c_str());
+            continue;
+          }
+          boundary = *filter_boundary;
+        }
+        // Boundaries should be strictly increasing, otherwise keep accumulating the current range.
+        if (boundary.empty() ||
+            (!boundary_keys_.empty() &&
+             cfd_comparator->Compare(boundary, boundary_keys_.back()) <= 0)) {
+          continue;
+        }
+        boundary_keys_.push_back(boundary.ToBuffer());
         sizes_.emplace_back(sum);
         subcompactions--;
         sum = 0;
       }
     }
     sizes_.emplace_back(sum + ranges.back().size);
+    boundaries_.assign(boundary_keys_.begin(), boundary_keys_.end());
   } else {
     // Only one range so its size is the total sum of sizes computed above
     sizes_.emplace_back(sum);
@@ -489,6 +624,8 @@ Result<FileNumbersHolder> CompactionJob::Run() {
     listener->OnCompactionStarted();
   }
 
+  PrepareSubcompactions();
+
   const size_t num_threads = compact_->sub_compact_states.size();
   assert(num_threads > 0);
   const uint64_t start_micros = env_->NowMicros();
@@ -498,9 +635,17 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   thread_pool.reserve(num_threads - 1);
   FileNumbersHolder file_numbers_holder(file_numbers_provider_->CreateHolder());
   file_numbers_holder.Reserve(num_threads);
+  if (num_threads > 1 && compact_->compaction->suspender()) {
+    subcompaction_suspender_.reset(
+        new SubcompactionSuspender(compact_->compaction->suspender()));
+  }
   for (size_t i = 1; i < compact_->sub_compact_states.size(); i++) {
-    thread_pool.emplace_back(&CompactionJob::ProcessKeyValueCompaction, this, &file_numbers_holder,
-                             &compact_->sub_compact_states[i]);
+    thread_pool.emplace_back([this, &file_numbers_holder, i] {
+      ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[i]);
+      if (subcompaction_suspender_) {
+        subcompaction_suspender_->SubcompactionFinished();
+      }
+    });
   }
 
   // Always schedule the first subcompaction (whether or not there are also
@@ -508,6 +653,9 @@ Result<FileNumbersHolder> CompactionJob::Run() {
   ProcessKeyValueCompaction(&file_numbers_holder, &compact_->sub_compact_states[0]);
 
   // Wait for all other threads (if there are any) to finish execution
+  if (subcompaction_suspender_) {
+    subcompaction_suspender_->WaitSubcompactions(num_threads - 1);
+  }
   for (auto& thread : thread_pool) {
     thread.join();
   }
@@ -660,7 +808,11 @@ void CompactionJob::ProcessKeyValueCompaction(
   if (compaction_filter) {
     // This is used to persist the history cutoff hybrid time chosen for the DocDB compaction
     // filter.
-    largest_user_frontier_ = compaction_filter->GetLargestUserFrontier();
+    auto frontier = compaction_filter->GetLargestUserFrontier();
+    if (frontier) {
+      std::lock_guard<std::mutex> lock(largest_user_frontier_mutex_);
+      UpdateUserFrontier(&largest_user_frontier_, frontier, UpdateUserValueType::kLargest);
+    }
   }
 
   MergeHelper merge(
@@ -970,9 +1122,27 @@ Status CompactionJob::InstallCompactionResults(
   // Add compaction outputs
   compaction->AddInputDeletions(compaction->edit());
 
+  // Outputs of subcompactions into level 0 form a single sorted run, see IsSameLevel0SortedRun.
+  // Number of the first output file is used as the sorted run id.
+  uint64_t sorted_run_id = 0;
+  if (compaction->output_level() == 0 && compact_->sub_compact_states.size() > 1) {
+    for (const auto& sub_compact : compact_->sub_compact_states) {
+      if (!sub_compact.outputs.empty()) {
+        sorted_run_id = sub_compact.outputs.front().meta.fd.GetNumber();
+        break;
+      }
+    }
+  }
+
   for (const auto& sub_compact : compact_->sub_compact_states) {
     for (const auto& out : sub_compact.outputs) {
-      compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      if (sorted_run_id != 0) {
+        FileMetaData meta = out.meta;
+        meta.sorted_run_id = sorted_run_id;
+        compaction->edit()->AddFile(compaction->output_level(), meta);
+      } else {
+        compaction->edit()->AddFile(compaction->output_level(), out.meta);
+      }
     }
   }
   if (largest_user_frontier_) {
@@ -1048,8 +1218,9 @@ Status CompactionJob::OpenCompactionOutputFile(
       if (preallocation_block_size > 0) {
         (*writable_file)->SetPreallocationBlockSize(preallocation_block_size);
       }
-      writer->reset(new WritableFileWriter(
-          std::move(*writable_file), env_options_, sub_compact->compaction->suspender()));
+      auto* suspender = subcompaction_suspender_
+          ? subcompaction_suspender_.get() : sub_compact->compaction->suspender();
+      writer->reset(new WritableFileWriter(std::move(*writable_file), env_options_, suspender));
     };
 
     const bool is_split_sst = cfd->ioptions()->table_factory->IsSplitSstForWriteSupported();
@@ -30,6 +30,7 @@
 #include <deque>
 #include <functional>
 #include <limits>
+#include <mutex>
 #include <set>
 #include <string>
 #include <utility>
@@ -107,9 +108,11 @@ class CompactionJob {
 
  private:
   struct SubcompactionState;
+  class SubcompactionSuspender;
 
   void AggregateStatistics();
-  void GenSubcompactionBoundaries();
+  void PrepareSubcompactions();
+  void GenSubcompactionBoundaries(Version* v);
 
   // update the thread status for starting a compaction.
   void ReportStartedCompaction(Compaction* compaction);
@@ -181,11 +184,19 @@ class CompactionJob {
   bool bottommost_level_;
   bool paranoid_file_checks_;
   bool measure_io_stats_;
+  // Stores the keys that designate the boundaries for each subcompaction
+  std::vector<std::string> boundary_keys_;
   // Stores the Slices that designate the boundaries for each subcompaction
   std::vector<Slice> boundaries_;
   // Stores the approx size of keys covered in the range of each subcompaction
   std::vector<uint64_t> sizes_;
+  // Version pinned by Prepare to generate subcompaction boundaries in Run.
+  Version* subcompaction_input_version_ = nullptr;
+  // Shared by all subcompactions when the compaction runs on a priority thread pool worker.
+  std::unique_ptr<SubcompactionSuspender> subcompaction_suspender_;
 
+  // Subcompactions run their own compaction filters, so frontiers are merged under this mutex.
+  std::mutex largest_user_frontier_mutex_;
   UserFrontierPtr largest_user_frontier_;
 };
 
@@ -60,6 +60,30 @@ uint64_t TotalCompensatedFileSize(const std::vector<FileMetaData*>& files) {
   return sum;
 }
 
+// Gives compaction_output_path_selector a chance to override the output path chosen by size,
+// using the largest user frontier of the compaction inputs.
+uint32_t SelectOutputPathId(
+    const ImmutableCFOptions& ioptions, const std::vector<CompactionInputFiles>& inputs,
+    uint32_t path_id) {
+  if (!ioptions.compaction_output_path_selector) {
+    return path_id;
+  }
+  UserFrontierPtr largest;
+  for (const auto& level_inputs : inputs) {
+    for (const auto* file : level_inputs.files) {
+      if (!file->largest.user_frontier) {
+        return path_id;
+      }
+      UpdateUserFrontier(&largest, file->largest.user_frontier, UpdateUserValueType::kLargest);
+    }
+  }
+  if (!largest) {
+    return path_id;
+  }
+  auto result = (*ioptions.compaction_output_path_selector)(*largest);
+  return result < ioptions.db_paths.size() ? result : path_id;
+}
+
 // Universal compaction is not supported in ROCKSDB_LITE
 #ifndef ROCKSDB_LITE
 
@@ -511,6 +535,9 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
         return nullptr;
       }
     }
+    if (output_path_id == 0) {
+      output_path_id = SelectOutputPathId(ioptions_, inputs, output_path_id);
+    }
     auto c = std::make_unique<Compaction>(
         vstorage, mutable_cf_options, std::move(inputs), output_level,
         mutable_cf_options.MaxFileSizeForLevel(output_level),
@@ -609,6 +636,10 @@ std::unique_ptr<Compaction> CompactionPicker::CompactRange(
     }
   }
 
+  if (ioptions_.compaction_style == kCompactionStyleUniversal && output_path_id == 0) {
+    output_path_id = SelectOutputPathId(ioptions_, compaction_inputs, output_path_id);
+  }
+
   std::vector<FileMetaData*> grandparents;
   GetGrandparents(vstorage, inputs, output_level_inputs, &grandparents);
   auto compaction = std::make_unique<Compaction>(
@@ -1162,6 +1193,17 @@ struct UniversalCompactionPicker::SortedRun {
     assert(compensated_file_size > 0);
     // Allowed either one of level and file.
     assert((level != 0) != (file != nullptr));
+    if (file) {
+      files.push_back(file);
+    }
+  }
+
+  // Adds level 0 file that belongs to the same sorted run, see IsSameLevel0SortedRun.
+  void AddFile(FileMetaData* f) {
+    files.push_back(f);
+    size += f->fd.GetTotalFileSize();
+    compensated_file_size += f->compensated_file_size;
+    being_compacted = being_compacted || f->being_compacted;
   }
 
   void Dump(char* out_buf, size_t out_buf_size,
@@ -1175,6 +1217,9 @@ struct UniversalCompactionPicker::SortedRun {
   // `file` Will be null for level > 0. For level = 0, the sorted run is
   // for this file.
   FileMetaData* file;
+  // For level = 0, all files of the sorted run starting with `file`. There are several of them
+  // when the sorted run was produced by a compaction split into subcompactions.
+  std::vector<FileMetaData*> files;
   // For level > 0, `size` and `compensated_file_size` are sum of sizes all
   // files in the level. `being_compacted` should be the same for all files
   // in a non-zero level. Use the value here.
@@ -1209,8 +1254,7 @@ void UniversalCompactionPicker::SortedRun::DumpSizeInfo(
              "file %" PRIu64 "[%" ROCKSDB_PRIszt
              "] "
              "with size %" PRIu64 " (compensated size %" PRIu64 ")",
-             file->fd.GetNumber(), sorted_run_count, file->fd.GetTotalFileSize(),
-             file->compensated_file_size);
+             file->fd.GetNumber(), sorted_run_count, size, compensated_file_size);
   } else {
     snprintf(out_buf, out_buf_size,
              "level %d[%" ROCKSDB_PRIszt
@@ -1225,10 +1269,15 @@ std::vector<std::vector<UniversalCompactionPicker::SortedRun>>
                                                    const ImmutableCFOptions& ioptions,
                                                    uint64_t max_file_size) {
   std::vector<std::vector<SortedRun>> ret(1);
-  for (FileMetaData* f : vstorage.LevelFiles(0)) {
-    if (f->fd.GetTotalFileSize() <= max_file_size) {
-      ret.back().emplace_back(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size,
-          f->being_compacted);
+  const auto& level0_files = vstorage.LevelFiles(0);
+  for (size_t i = 0; i != level0_files.size();) {
+    FileMetaData* f = level0_files[i];
+    SortedRun run(0, f, f->fd.GetTotalFileSize(), f->compensated_file_size, f->being_compacted);
+    for (++i; i != level0_files.size() && IsSameLevel0SortedRun(*f, *level0_files[i]); ++i) {
+      run.AddFile(level0_files[i]);
+    }
+    if (run.size <= max_file_size) {
+      ret.back().push_back(std::move(run));
     // If last sequence is empty it means that there are multiple too-large-to-compact files in
     // a row. So we just don't start new sequence in this case.
     } else if (!ret.back().empty()) {
@@ -1455,14 +1504,22 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
 
   size_t level_index = 0U;
   if (c->start_level() == 0) {
+    const FileMetaData* prev_file = nullptr;
     for (auto f : *c->inputs(0)) {
       DCHECK_LE(f->smallest.seqno, f->largest.seqno);
       if (is_first) {
         is_first = false;
+      } else if (IsSameLevel0SortedRun(*prev_file, *f)) {
+        // Files of the same sorted run could overlap in time, so the smallest seqno of the whole
+        // sorted run is checked against the next one.
+        prev_smallest_seqno = std::min(prev_smallest_seqno, f->smallest.seqno);
+        prev_file = f;
+        continue;
       } else {
         DCHECK_GT(prev_smallest_seqno, f->largest.seqno);
       }
       prev_smallest_seqno = f->smallest.seqno;
+      prev_file = f;
     }
     level_index = 1U;
   }
@@ -1692,8 +1749,9 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   for (size_t i = start_index; i < first_index_after; i++) {
     auto& picking_sr = sorted_runs[i];
     if (picking_sr.level == 0) {
-      FileMetaData* picking_file = picking_sr.file;
-      inputs[0].files.push_back(picking_file);
+      for (auto* picking_file : picking_sr.files) {
+        inputs[0].files.push_back(picking_file);
+      }
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1712,6 +1770,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalRe
   } else {
     compaction_reason = CompactionReason::kUniversalSizeRatio;
   }
+  path_id = SelectOutputPathId(ioptions_, inputs, path_id);
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs), output_level,
       mutable_cf_options.MaxFileSizeForLevel(output_level), LLONG_MAX, path_id,
@@ -1818,8 +1877,9 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
   for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
     auto& picking_sr = sorted_runs[loop];
     if (picking_sr.level == 0) {
-      FileMetaData* f = picking_sr.file;
-      inputs[0].files.push_back(f);
+      for (auto* f : picking_sr.files) {
+        inputs[0].files.push_back(f);
+      }
     } else {
       auto& files = inputs[picking_sr.level - start_level].files;
       for (auto* f : vstorage->LevelFiles(picking_sr.level)) {
@@ -1832,6 +1892,7 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
                 cf_name.c_str(), file_num_buf);
   }
 
+  path_id = SelectOutputPathId(ioptions_, inputs, path_id);
   return std::make_unique<Compaction>(
       vstorage, mutable_cf_options, std::move(inputs),
       vstorage->num_levels() - 1,
@@ -416,6 +416,61 @@ TEST_F(CompactionPickerTest, NeedsCompactionUniversal) {
               vstorage_->CompactionScore(0) >= 1);
   }
 }
+
+// Outputs of a compaction split into subcompactions have the same sorted run id and should be
+// counted as a single sorted run, while their sequence number ranges could overlap.
+TEST_F(CompactionPickerTest, UniversalSubcompactionOutputsSortedRun) {
+  const uint64_t kFileSize = 100000;
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+  Add(0, 7U, "100", "900", kFileSize, 0, 701, 750);
+  Add(0, 6U, "100", "900", kFileSize, 0, 601, 650);
+  Add(0, 5U, "600", "900", kFileSize, 0, 5, 470);
+  Add(0, 4U, "300", "599", kFileSize, 0, 2, 500);
+  Add(0, 3U, "100", "299", kFileSize, 0, 1, 480);
+  for (uint32_t file_number : {3U, 4U, 5U}) {
+    file_map_[file_number].first->sorted_run_id = 3;
+  }
+  UpdateVersionStorageInfo();
+
+  ASSERT_EQ(
+      3.0 / mutable_cf_options_.level0_file_num_compaction_trigger, vstorage_->CompactionScore(0));
+  ASSERT_EQ(3, vstorage_->l0_delay_trigger_count());
+}
+
+// Compaction output path could be overridden based on the largest user frontier of input files.
+TEST_F(CompactionPickerTest, UniversalOutputPathSelector) {
+  constexpr uint64_t kFileSize = 100000;
+  constexpr uint64_t kColdFrontier = 1000;
+
+  ioptions_.db_paths.emplace_back("dummy_cold", std::numeric_limits<uint64_t>::max());
+  ioptions_.compaction_output_path_selector = std::make_shared<CompactionOutputPathSelector>(
+      [](const UserFrontier& largest) -> uint32_t {
+    return down_cast<const test::TestUserFrontier&>(largest).Value() < kColdFrontier ? 1 : 0;
+  });
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  for (uint64_t newest_frontier : {kColdFrontier - 1, kColdFrontier, 0ULL}) {
+    NewVersionStorage(1, kCompactionStyleUniversal);
+    for (uint32_t i = 1; i <= 4; ++i) {
+      Add(0, i, "150", "200", kFileSize, 0, i * 100, i * 100 + 99);
+      // Zero means that the newest file does not have user frontier.
+      if (i != 4 || newest_frontier != 0) {
+        files_.back()->largest.user_frontier.reset(
+            new test::TestUserFrontier(i == 4 ? newest_frontier : i));
+      }
+    }
+    UpdateVersionStorageInfo();
+
+    std::unique_ptr<Compaction> compaction(universal_compaction_picker.PickCompaction(
+        cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+    ASSERT_TRUE(compaction);
+    ASSERT_EQ(4U, compaction->num_input_files(0));
+    ASSERT_EQ(newest_frontier == kColdFrontier - 1 ? 1U : 0U, compaction->output_path_id());
+    universal_compaction_picker.ReleaseCompactionFiles(compaction.get(), Status::OK());
+  }
+}
+
 // Tests if the files can be trivially moved in multi level
 // universal compaction when allow_trivial_move option is set
 // In this test as the input files overlaps, they cannot
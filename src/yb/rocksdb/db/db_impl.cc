@@ -57,6 +57,9 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/priority_thread_pool.h"
 #include "yb/util/atomic.h"
+#include "yb/util/countdown_latch.h"
+#include "yb/util/threadpool.h"
+#include "yb/util/scope_exit.h"
 
 #include "yb/rocksdb/db/auto_roll_logger.h"
 #include "yb/rocksdb/db/builder.h"
@@ -4363,7 +4366,7 @@ Status DBImpl::CreateColumnFamily(const ColumnFamilyOptions& cf_options,
   *handle = nullptr;
 
   s = CheckCompressionSupported(cf_options);
-  if (s.ok() && db_options_.allow_concurrent_memtable_write) {
+  if (s.ok() && (db_options_.allow_concurrent_memtable_write || db_options_.memtable_insert_pool)) {
     s = CheckConcurrentWritesSupported(cf_options);
   }
   if (!s.ok()) {
@@ -4794,6 +4797,52 @@ Status DBImpl::WriteWithCallback(const WriteOptions& write_options,
 }
 #endif  // ROCKSDB_LITE
 
+bool DBImpl::ShouldInsertIntoMemTableInParallel(const WriteBatch& batch) const {
+  return db_options_.memtable_insert_pool && db_options_.max_memtable_insert_parts > 1 &&
+         WriteBatchInternal::Count(&batch) >= 2 * db_options_.min_entries_per_memtable_insert_part &&
+         !batch.HasMerge();
+}
+
+Status DBImpl::InsertIntoMemTableInParallel(
+    const WriteOptions& write_options, const WriteBatch& batch, SequenceNumber sequence) {
+  const size_t count = WriteBatchInternal::Count(&batch);
+  const size_t num_parts = std::min(
+      db_options_.max_memtable_insert_parts,
+      count / std::max<size_t>(db_options_.min_entries_per_memtable_insert_part, 1));
+  std::vector<Status> statuses(num_parts);
+  auto insert_part = [this, &write_options, &batch, sequence, count, num_parts, &statuses](
+      size_t part) {
+    TEST_SYNC_POINT_CALLBACK("DBImpl::InsertIntoMemTableInParallel:Part", &part);
+    // Each thread should use its own instance of ColumnFamilyMemTables.
+    ColumnFamilyMemTablesImpl column_family_memtables(versions_->GetColumnFamilySet());
+    statuses[part] = WriteBatchInternal::InsertInto(
+        &batch, sequence, count * part / num_parts, count * (part + 1) / num_parts,
+        &column_family_memtables, &flush_scheduler_, write_options.ignore_missing_column_families,
+        this, InsertFlags{InsertFlag::kFilterDeletes, InsertFlag::kConcurrentMemtableWrites});
+  };
+
+  yb::CountDownLatch latch(num_parts - 1);
+  for (size_t part = 1; part != num_parts; ++part) {
+    auto submit_status = db_options_.memtable_insert_pool->SubmitFunc(
+        [&insert_part, &latch, part] {
+      insert_part(part);
+      latch.CountDown();
+    });
+    if (!submit_status.ok()) {
+      // Pool could be shutting down, insert this part in the current thread.
+      insert_part(part);
+      latch.CountDown();
+    }
+  }
+  insert_part(0);
+  latch.Wait();
+
+  for (auto& status : statuses) {
+    RETURN_NOT_OK(status);
+  }
+  return Status::OK();
+}
+
 Status DBImpl::WriteImpl(const WriteOptions& write_options,
                          WriteBatch* my_batch, WriteCallback* callback) {
 
@@ -5148,7 +5197,11 @@ Status DBImpl::WriteImpl(const WriteOptions& write_options,
         }
       }
 
-      if (!parallel) {
+      if (!parallel && write_group.size() == 1 && !w.CallbackFailed() &&
+          ShouldInsertIntoMemTableInParallel(*w.batch)) {
+        w.status = InsertIntoMemTableInParallel(write_options, *w.batch, current_sequence);
+        status = w.FinalStatus();
+      } else if (!parallel) {
         InsertFlags insert_flags{InsertFlag::kFilterDeletes};
         status = WriteBatchInternal::InsertInto(
             write_group, current_sequence, column_family_memtables_.get(),
@@ -5666,6 +5719,28 @@ Result<std::string> DBImpl::GetMiddleKey() {
   return default_cf_handle_->cfd()->current()->GetMiddleKey();
 }
 
+Result<std::vector<std::string>> DBImpl::GetSplitKeys(size_t num_parts) {
+  // Split keys are read from the table readers, so the current version is pinned by the super
+  // version instead of holding mutex_ during I/O.
+  auto cfd = default_cf_handle_->cfd();
+  SuperVersion* sv = GetAndRefSuperVersion(cfd);
+  auto se = yb::ScopeExit([this, cfd, sv] {
+    ReturnAndCleanupSuperVersion(cfd, sv);
+  });
+  const auto version_number = sv->current->GetVersionNumber();
+  {
+    std::lock_guard<std::mutex> lock(split_keys_mutex_);
+    if (split_keys_cache_.version_number == version_number &&
+        split_keys_cache_.num_parts == num_parts) {
+      return split_keys_cache_.keys;
+    }
+  }
+  auto keys = VERIFY_RESULT(sv->current->GetSplitKeys(num_parts));
+  std::lock_guard<std::mutex> lock(split_keys_mutex_);
+  split_keys_cache_ = SplitKeysCache{version_number, num_parts, keys};
+  return keys;
+}
+
 void DBImpl::TEST_SwitchMemtable() {
   std::lock_guard<InstrumentedMutex> lock(mutex_);
   WriteContext context;
@@ -6129,7 +6204,7 @@ Status DB::Open(const DBOptions& db_options, const std::string& dbname,
 
   for (auto& cfd : column_families) {
     s = CheckCompressionSupported(cfd.options);
-    if (s.ok() && db_options.allow_concurrent_memtable_write) {
+    if (s.ok() && (db_options.allow_concurrent_memtable_write || db_options.memtable_insert_pool)) {
       s = CheckConcurrentWritesSupported(cfd.options);
     }
     if (!s.ok()) {
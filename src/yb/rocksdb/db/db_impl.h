@@ -476,6 +476,8 @@ class DBImpl : public DB {
 
   Result<std::string> GetMiddleKey() override;
 
+  Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) override;
+
   // Used in testing to make the old memtable immutable and start writing to a new one.
   void TEST_SwitchMemtable() override;
 
@@ -522,6 +524,15 @@ class DBImpl : public DB {
                    WriteCallback* callback);
 
  private:
+  // Returns true if the batch is large enough to be inserted into memtables by several threads,
+  // see DBOptions::memtable_insert_pool.
+  bool ShouldInsertIntoMemTableInParallel(const WriteBatch& batch) const;
+
+  // Splits the batch into ranges of entries that are inserted into memtables in parallel by the
+  // current thread and threads of memtable_insert_pool.
+  Status InsertIntoMemTableInParallel(
+      const WriteOptions& write_options, const WriteBatch& batch, SequenceNumber sequence);
+
   friend class DB;
   friend class InternalStats;
 #ifndef ROCKSDB_LITE
@@ -989,6 +1000,17 @@ class DBImpl : public DB {
   // Whether DB should be flushed on shutdown.
   bool disable_flush_on_shutdown_ = false;
 
+  // Split keys of the last version they were requested for. SST files are changed only by flushes
+  // and compactions, so split keys are calculated once per such change.
+  struct SplitKeysCache {
+    uint64_t version_number = std::numeric_limits<uint64_t>::max();
+    size_t num_parts = 0;
+    std::vector<std::string> keys;
+  };
+
+  std::mutex split_keys_mutex_;
+  SplitKeysCache split_keys_cache_ GUARDED_BY(split_keys_mutex_);
+
   mutable std::mutex files_changed_listener_mutex_;
 
   std::function<void()> files_changed_listener_ GUARDED_BY(files_changed_listener_mutex_);
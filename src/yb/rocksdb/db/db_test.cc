@@ -86,6 +86,7 @@
 #include "yb/rocksdb/util/testutil.h"
 #include "yb/rocksdb/util/mock_env.h"
 #include "yb/util/string_util.h"
+#include "yb/util/threadpool.h"
 #include "yb/rocksdb/util/thread_status_util.h"
 #include "yb/rocksdb/util/xfunc.h"
 #include "yb/util/tsan_util.h"
@@ -4802,6 +4803,10 @@ class ModelDB: public DB {
     return NotSupported();
   }
 
+  Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) override {
+    return NotSupported();
+  }
+
  private:
   CHECKED_STATUS NotSupported() const {
     return STATUS(NotSupported, "Not supported in Model DB");
@@ -5301,6 +5306,96 @@ TEST_F(DBTest, ConcurrentMemtableNotSupported) {
   ASSERT_NOK(db_->CreateColumnFamily(cf_options, "name", &handle));
 }
 
+TEST_F(DBTest, ParallelMemTableInsert) {
+  constexpr int kNumKeys = 200;
+  constexpr size_t kNumParts = 4;
+
+  std::unique_ptr<yb::ThreadPool> pool;
+  ASSERT_OK(yb::ThreadPoolBuilder("memtable-insert").set_max_threads(2).Build(&pool));
+
+  Options options = CurrentOptions();
+  options.memtable_factory.reset(new SkipListFactory);
+  options.memtable_insert_pool = pool.get();
+  options.max_memtable_insert_parts = kNumParts;
+  options.min_entries_per_memtable_insert_part = kNumKeys / kNumParts;
+  DestroyAndReopen(options);
+
+  std::atomic<size_t> num_parts(0);
+  rocksdb::SyncPoint::GetInstance()->SetCallBack(
+      "DBImpl::InsertIntoMemTableInParallel:Part", [&](void* arg) { ++num_parts; });
+  rocksdb::SyncPoint::GetInstance()->EnableProcessing();
+
+  // The second half of the batch overwrites the first one, so the result is correct only when
+  // each part gets the same sequence numbers as in a sequential insert.
+  WriteBatch batch;
+  for (int i = 0; i != kNumKeys / 2; ++i) {
+    batch.Put(Key(i), "a");
+  }
+  for (int i = 0; i != kNumKeys / 2; ++i) {
+    if (i % 2) {
+      batch.Put(Key(i), "b");
+    } else {
+      batch.Delete(Key(i));
+    }
+  }
+  const SequenceNumber sequence = db_->GetLatestSequenceNumber();
+  ASSERT_OK(db_->Write(WriteOptions(), &batch));
+
+  rocksdb::SyncPoint::GetInstance()->DisableProcessing();
+  rocksdb::SyncPoint::GetInstance()->ClearAllCallBacks();
+
+#ifndef NDEBUG
+  ASSERT_EQ(kNumParts, num_parts.load());
+#endif
+  ASSERT_EQ(sequence + kNumKeys, db_->GetLatestSequenceNumber());
+
+  for (int flush = 0; flush != 2; ++flush) {
+    for (int i = 0; i != kNumKeys / 2; ++i) {
+      ASSERT_EQ(i % 2 ? "b" : "NOT_FOUND", Get(Key(i))) << "Key: " << i << ", flush: " << flush;
+    }
+    ASSERT_OK(Flush());
+  }
+
+  Close();
+}
+
+TEST_F(DBTest, SplitKeysOfSeveralFiles) {
+  constexpr int kNumKeys = 1000;
+  Options options = CurrentOptions();
+  options.disable_auto_compactions = true;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+  DestroyAndReopen(options);
+
+  // The first file contains the lower half of keys with values that are three times larger than
+  // values of the upper half in the second file.
+  for (int i = 0; i != kNumKeys / 2; ++i) {
+    ASSERT_OK(Put(Key(i), std::string(300, 'a')));
+  }
+  ASSERT_OK(Flush());
+  for (int i = kNumKeys / 2; i != kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), std::string(100, 'b')));
+  }
+  ASSERT_OK(Flush());
+
+  // Keys are sampled from both files, so the last of 4 ranges of roughly the same size starts in
+  // the second file.
+  const auto split_keys = ASSERT_RESULT(db_->GetSplitKeys(4));
+  ASSERT_EQ(3, split_keys.size());
+  ASSERT_TRUE(std::is_sorted(split_keys.begin(), split_keys.end()));
+  ASSERT_LT(split_keys[1], Key(kNumKeys / 2));
+  ASSERT_GE(split_keys[2], Key(kNumKeys / 2));
+
+  // Split keys are calculated again only when SST files change.
+  ASSERT_EQ(split_keys, ASSERT_RESULT(db_->GetSplitKeys(4)));
+  for (int i = kNumKeys; i != 2 * kNumKeys; ++i) {
+    ASSERT_OK(Put(Key(i), std::string(300, 'c')));
+  }
+  ASSERT_OK(Flush());
+  ASSERT_GE(ASSERT_RESULT(db_->GetSplitKeys(4)).back(), Key(kNumKeys));
+}
+
 #endif  // ROCKSDB_LITE
 
 TEST_F(DBTest, SanitizeNumThreads) {
@@ -1474,6 +1474,67 @@ TEST_F(DBTestUniversalCompaction, IncludeFilesSmallerThanThreshold) {
   GenerateFilesAndCheckCompactionResult(options, file_sizes, value_size, 1);
 }
 
+// Checkpoints put all table files to the DB dir, so files recorded in the manifest with another
+// path should be found there and their path id should be normalized.
+TEST_F(DBTestUniversalCompaction, FilesMovedFromOtherPath) {
+  constexpr int kNumKeys = 100;
+
+  Options options = CurrentOptions();
+  options.env = env_;
+  options.create_if_missing = true;
+  options.compaction_style = kCompactionStyleUniversal;
+  options.db_paths.emplace_back(dbname_, std::numeric_limits<uint64_t>::max());
+  options.db_paths.emplace_back(dbname_ + "_2", std::numeric_limits<uint64_t>::max());
+
+  // With unlimited open files table readers are loaded before path ids are normalized, so they
+  // are found by TableCache in other paths.
+  for (int max_open_files : {-1, 5000}) {
+    options.max_open_files = max_open_files;
+    Destroy(options);
+    DestroyAndReopen(options);
+    for (int i = 0; i != kNumKeys; ++i) {
+      ASSERT_OK(Put(Key(i), Key(i)));
+    }
+    ASSERT_OK(Flush());
+
+    CompactRangeOptions compact_options;
+    compact_options.target_path_id = 1;
+    ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+    ASSERT_EQ(0, GetSstFileCount(options.db_paths[0].path));
+    ASSERT_EQ(1, GetSstFileCount(options.db_paths[1].path));
+    Close();
+
+    std::vector<std::string> filenames;
+    ASSERT_OK(env_->GetChildren(options.db_paths[1].path, &filenames));
+    for (const auto& filename : filenames) {
+      if (filename != "." && filename != "..") {
+        ASSERT_OK(env_->RenameFile(options.db_paths[1].path + "/" + filename,
+                                   dbname_ + "/" + filename));
+      }
+    }
+
+    Reopen(options);
+    for (int i = 0; i != kNumKeys; ++i) {
+      ASSERT_EQ(Key(i), Get(Key(i)));
+    }
+    std::vector<LiveFileMetaData> metadata;
+    db_->GetLiveFilesMetaData(&metadata);
+    ASSERT_EQ(1U, metadata.size());
+    ASSERT_EQ(dbname_, metadata[0].db_path);
+
+    // Input file is deleted from the path where it was actually found.
+    compact_options.target_path_id = 0;
+    ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+    ASSERT_EQ(1, GetSstFileCount(options.db_paths[0].path));
+    ASSERT_EQ(0, GetSstFileCount(options.db_paths[1].path));
+
+    Reopen(options);
+    for (int i = 0; i != kNumKeys; ++i) {
+      ASSERT_EQ(Key(i), Get(Key(i)));
+    }
+  }
+}
+
 }  // namespace rocksdb
 
 #endif  // !defined(ROCKSDB_LITE)
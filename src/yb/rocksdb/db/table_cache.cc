@@ -130,6 +130,27 @@ Status NewFileReader(const ImmutableCFOptions& ioptions, const EnvOptions& env_o
   return Status::OK();
 }
 
+// Files are written to db_paths[path_id], but checkpoints, remote bootstrap and restored snapshots
+// put all table files to the DB dir. So look for the file in other paths when it is missing from
+// the path recorded in the manifest. Path ids are also normalized on recovery, but table readers
+// could be loaded before that.
+std::string FindTableFile(const ImmutableCFOptions& ioptions, const FileDescriptor& fd) {
+  auto result = TableFileName(ioptions.db_paths, fd.GetNumber(), fd.GetPathId());
+  if (ioptions.db_paths.size() <= 1 || ioptions.env->FileExists(result).ok()) {
+    return result;
+  }
+  for (uint32_t path_id = 0; path_id != ioptions.db_paths.size(); ++path_id) {
+    if (path_id == fd.GetPathId()) {
+      continue;
+    }
+    auto fname = TableFileName(ioptions.db_paths, fd.GetNumber(), path_id);
+    if (ioptions.env->FileExists(fname).ok()) {
+      return fname;
+    }
+  }
+  return result;
+}
+
 } // anonymous namespace
 
 Status TableCache::DoGetTableReader(
@@ -137,7 +158,7 @@ Status TableCache::DoGetTableReader(
     const InternalKeyComparatorPtr& internal_comparator, const FileDescriptor& fd,
     bool sequential_mode, bool record_read_stats, HistogramImpl* file_read_hist,
     unique_ptr<TableReader>* table_reader, bool skip_filters) {
-  const std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
+  const std::string base_fname = FindTableFile(ioptions_, fd);
 
   Status s;
   {
@@ -97,6 +97,9 @@ struct FileMetaData {
   BoundaryValues smallest;  // The smallest values in this file
   BoundaryValues largest;   // The largest values in this file
   bool imported = false;    // Was this file imported from another DB.
+  // Non zero for level 0 files that form a single sorted run with other files, i.e. outputs of
+  // a compaction split into subcompactions. See IsSameLevel0SortedRun.
+  uint64_t sorted_run_id = 0;
 
   // Needs to be disposed when refs becomes 0.
   Cache::Handle* table_reader_handle;
@@ -135,6 +138,13 @@ struct FileMetaData {
   std::string ToString() const;
 };
 
+// Level 0 files are ordered by sequence numbers and each of them is usually a separate sorted run.
+// But when compaction into level 0 is split into subcompactions, its outputs have non-overlapping
+// key ranges and together form a single sorted run, identified by sorted_run_id.
+inline bool IsSameLevel0SortedRun(const FileMetaData& lhs, const FileMetaData& rhs) {
+  return lhs.sorted_run_id != 0 && lhs.sorted_run_id == rhs.sorted_run_id;
+}
+
 class VersionEdit {
  public:
   VersionEdit() { Clear(); }
@@ -197,6 +207,7 @@ class VersionEdit {
     nf.largest = f.largest;
     nf.marked_for_compaction = f.marked_for_compaction;
     nf.imported = f.imported;
+    nf.sorted_run_id = f.sorted_run_id;
     new_files_.emplace_back(level, std::move(nf));
   }
 
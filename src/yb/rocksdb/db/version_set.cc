@@ -1243,11 +1243,15 @@ void VersionStorageInfo::ComputeCompactionScore(
       // overwrites/deletions).
       int num_sorted_runs = 0;
       uint64_t total_size = 0;
+      const FileMetaData* prev_file = nullptr;
       for (auto* f : files_[level]) {
         if (!f->being_compacted) {
           total_size += f->compensated_file_size;
-          num_sorted_runs++;
+          if (!prev_file || !IsSameLevel0SortedRun(*prev_file, *f)) {
+            num_sorted_runs++;
+          }
         }
+        prev_file = f;
       }
       if (compaction_style_ == kCompactionStyleUniversal) {
         // For universal compaction, we use level0 score to indicate
@@ -1879,15 +1883,19 @@ void VersionStorageInfo::CalculateBaseBytes(const ImmutableCFOptions& ioptions,
                                             const MutableCFOptions& options) {
   // Special logic to set number of sorted runs.
   // It is to match the previous behavior when all files are in L0.
+  // Outputs of a compaction split into subcompactions are counted as a single sorted run.
   int num_l0_count = 0;
-  if (options.max_file_size_for_compaction == std::numeric_limits<uint64_t>::max()) {
-    num_l0_count = static_cast<int>(files_[0].size());
-  } else {
-    for (const auto& file : files_[0]) {
-      if (file->fd.GetTotalFileSize() <= options.max_file_size_for_compaction) {
-        ++num_l0_count;
-      }
-    }
+  for (size_t i = 0; i != files_[0].size();) {
+    uint64_t run_size = 0;
+    size_t j = i;
+    do {
+      run_size += files_[0][j]->fd.GetTotalFileSize();
+      ++j;
+    } while (j != files_[0].size() && IsSameLevel0SortedRun(*files_[0][i], *files_[0][j]));
+    if (run_size <= options.max_file_size_for_compaction) {
+      ++num_l0_count;
+    }
+    i = j;
   }
   if (compaction_style_ == kCompactionStyleUniversal) {
     // For universal compaction, we use level0 score to indicate
@@ -2063,7 +2071,15 @@ std::string Version::DebugString(bool hex) const {
   return r;
 }
 
-Result<std::string> Version::GetMiddleKey() {
+Result<TableCache::TableReaderWithHandle> Version::GetTableReader(
+    const FileMetaData& file, int level, bool is_file_last_in_level) {
+  return table_cache_->GetTableReader(
+      vset_->env_options_, cfd_->internal_comparator(), file.fd, kDefaultQueryId,
+      /* no_io =*/ false, cfd_->internal_stats()->GetFileReadHist(level),
+      IsFilterSkipped(level, is_file_last_in_level));
+}
+
+Result<TableCache::TableReaderWithHandle> Version::GetLargestSstTableReader() {
   // Largest files are at lowest level.
   const auto level = storage_info_.num_levels_ - 1;
   const FileMetaData* largest_sst_meta = nullptr;
@@ -2077,13 +2093,78 @@ Result<std::string> Version::GetMiddleKey() {
     return STATUS(Incomplete, "No SST files.");
   }
 
-  const auto trwh = VERIFY_RESULT(table_cache_->GetTableReader(
-      vset_->env_options_, cfd_->internal_comparator(), largest_sst_meta->fd, kDefaultQueryId,
-      /* no_io =*/ false, cfd_->internal_stats()->GetFileReadHist(level),
-      IsFilterSkipped(level, /* is_file_last_in_level =*/ true)));
+  return GetTableReader(*largest_sst_meta, level, /* is_file_last_in_level =*/ true);
+}
+
+Result<std::string> Version::GetMiddleKey() {
+  const auto trwh = VERIFY_RESULT(GetLargestSstTableReader());
   return trwh.table_reader->GetMiddleKey();
 }
 
+Result<std::vector<std::string>> Version::GetSplitKeys(size_t num_parts) {
+  // Each file is split into the number of parts proportional to its size, so every sampled key
+  // represents the same amount of data. Several samples are taken for each requested part, so
+  // keys sampled from different files are combined into ranges of roughly the same size.
+  constexpr size_t kSamplesPerPart = 4;
+
+  struct SampledKey {
+    std::string key;
+    uint64_t weight;
+  };
+
+  uint64_t total_size = 0;
+  for (int level = 0; level < storage_info_.num_levels_; ++level) {
+    for (const auto* file : storage_info_.files_[level]) {
+      total_size += file->fd.GetTotalFileSize();
+    }
+  }
+  if (total_size == 0) {
+    return STATUS(Incomplete, "No SST files.");
+  }
+
+  std::vector<SampledKey> samples;
+  for (int level = 0; level < storage_info_.num_levels_; ++level) {
+    for (const auto* file : storage_info_.files_[level]) {
+      const auto file_size = file->fd.GetTotalFileSize();
+      const size_t file_parts = std::max<size_t>(
+          num_parts * kSamplesPerPart * file_size / total_size, 1);
+      if (file_parts < 2) {
+        continue;
+      }
+      auto keys = VERIFY_RESULT(GetSplitKeys(*file, level, file_parts));
+      const uint64_t weight = file_size / (keys.size() + 1);
+      for (auto& key : keys) {
+        samples.push_back(SampledKey{std::move(key), weight});
+      }
+    }
+  }
+
+  const auto* user_comparator = cfd_->user_comparator();
+  std::sort(samples.begin(), samples.end(),
+            [user_comparator](const SampledKey& lhs, const SampledKey& rhs) {
+    return user_comparator->Compare(lhs.key, rhs.key) < 0;
+  });
+
+  std::vector<std::string> result;
+  uint64_t accumulated = 0;
+  for (auto& sample : samples) {
+    accumulated += sample.weight;
+    if (accumulated * num_parts >= total_size * (result.size() + 1)) {
+      result.push_back(std::move(sample.key));
+      if (result.size() + 1 == num_parts) {
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+Result<std::vector<std::string>> Version::GetSplitKeys(
+    const FileMetaData& file, int level, size_t num_parts) {
+  const auto trwh = VERIFY_RESULT(GetTableReader(file, level, /* is_file_last_in_level =*/ false));
+  return trwh.table_reader->GetSplitKeys(num_parts);
+}
+
 // this is used to batch writes to the manifest file
 struct VersionSet::ManifestWriter {
   Status status;
@@ -2474,6 +2555,36 @@ void VersionSet::LogAndApplyHelper(
 
 namespace {
 
+// Table files are written to db_paths[path_id], but checkpoints, remote bootstrap and restored
+// snapshots put all of them to the DB dir. So path id of a file that is missing from the path
+// recorded in the manifest is replaced with the path that actually contains it. The new path id is
+// persisted when the next manifest is written.
+void NormalizeFilePathIds(
+    Env* env, const std::vector<DbPath>& db_paths, const std::shared_ptr<Logger>& info_log,
+    VersionStorageInfo* vstorage) {
+  for (int level = 0; level < vstorage->num_levels(); ++level) {
+    for (auto* file : vstorage->LevelFiles(level)) {
+      const auto number = file->fd.GetNumber();
+      const auto path_id = file->fd.GetPathId();
+      if (path_id == 0 ||
+          (path_id < db_paths.size() &&
+           env->FileExists(TableFileName(db_paths, number, path_id)).ok())) {
+        continue;
+      }
+      for (uint32_t new_path_id = 0; new_path_id != db_paths.size(); ++new_path_id) {
+        if (new_path_id != path_id &&
+            env->FileExists(TableFileName(db_paths, number, new_path_id)).ok()) {
+          RLOG(InfoLogLevel::INFO_LEVEL, info_log,
+              "Table file %" PRIu64 " found in path %" PRIu32 " instead of %" PRIu32,
+              number, new_path_id, path_id);
+          file->fd.packed_number_and_path_id = PackFileNumberAndPathId(number, new_path_id);
+          break;
+        }
+      }
+    }
+  }
+}
+
 struct LogReporter : public log::Reader::Reporter {
   Status* status;
   virtual void Corruption(size_t bytes, const Status& s) override {
@@ -2811,6 +2922,8 @@ Status VersionSet::Recover(
 
       Version* v = new Version(cfd, this, current_version_number_++);
       builder->SaveTo(v->storage_info());
+      NormalizeFilePathIds(
+          env_, cfd->ioptions()->db_paths, db_options_->info_log, v->storage_info());
 
       // Install recovered version
       v->PrepareApply(*cfd->GetLatestMutableCFOptions(),
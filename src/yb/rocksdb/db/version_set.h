@@ -521,6 +521,17 @@ class Version {
   // Returns Status(Incomplete) if there are no SST files for this version.
   Result<std::string> GetMiddleKey();
 
+  // Returns user keys in ascending order, which divide SST files of this version into up to
+  // num_parts key ranges of roughly the same size. Keys are sampled from all SST files in
+  // proportion to their sizes (see TableReader::GetSplitKeys).
+  // Returns Status(Incomplete) if there are no SST files for this version.
+  Result<std::vector<std::string>> GetSplitKeys(size_t num_parts);
+
+  // Returns user keys which divide the specified file of the specified level into num_parts ranges
+  // of roughly the same size.
+  Result<std::vector<std::string>> GetSplitKeys(
+      const FileMetaData& file, int level, size_t num_parts);
+
   ColumnFamilyData* cfd() const { return cfd_; }
 
   // Return the next Version in the linked list. Used for debug only
@@ -549,6 +560,12 @@ class Version {
                       InternalIterator* level_iter,
                       const Slice& internal_prefix) const;
 
+  Result<TableCache::TableReaderWithHandle> GetTableReader(
+      const FileMetaData& file, int level, bool is_file_last_in_level);
+
+  // Returns table reader for the largest SST file of the last level.
+  Result<TableCache::TableReaderWithHandle> GetLargestSstTableReader();
+
   // Returns true if the filter blocks in the specified level will not be
   // checked during read operations. In certain cases (trivial move or preload),
   // the filter block may already be cached, but we still do not access it such
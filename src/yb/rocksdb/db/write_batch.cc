@@ -43,6 +43,7 @@
 
 #include "yb/rocksdb/write_batch.h"
 
+#include <limits>
 #include <stack>
 #include <stdexcept>
 #include <vector>
@@ -295,7 +296,12 @@ Status WriteBatch::Iterate(Handler* handler) const {
   if (frontiers_) {
     s = handler->Frontiers(*frontiers_);
   }
-  while (s.ok() && !input.empty() && handler->Continue()) {
+  bool stopped_by_handler = false;
+  while (s.ok() && !input.empty()) {
+    if (!handler->Continue()) {
+      stopped_by_handler = true;
+      break;
+    }
     char tag = 0;
     uint32_t column_family = 0;  // default
 
@@ -344,7 +350,8 @@ Status WriteBatch::Iterate(Handler* handler) const {
   if (!s.ok()) {
     return s;
   }
-  if (found != WriteBatchInternal::Count(this)) {
+  // The number of entries could be checked only when the whole batch was iterated.
+  if (!stopped_by_handler && found != WriteBatchInternal::Count(this)) {
     return STATUS(Corruption, "WriteBatch has wrong count");
   } else {
     return Status::OK();
@@ -608,6 +615,16 @@ class MemTableInserter : public WriteBatch::Handler {
     }
   }
 
+  // Restricts inserted entries to the ones with indexes in [begin, end).
+  void SetEntriesRange(size_t begin, size_t end) {
+    entries_begin_ = begin;
+    entries_end_ = end;
+  }
+
+  bool Continue() override {
+    return entry_idx_ < entries_end_;
+  }
+
   bool SeekToColumnFamily(uint32_t column_family_id, Status* s) {
     // If we are in a concurrent mode, it is the caller's responsibility
     // to clone the original ColumnFamilyMemTables so that each thread
@@ -638,6 +655,9 @@ class MemTableInserter : public WriteBatch::Handler {
 
   virtual CHECKED_STATUS PutCF(uint32_t column_family_id, const Slice& key,
                                const Slice& value) override {
+    if (SkipEntry()) {
+      return Status::OK();
+    }
     Status seek_status;
     if (!SeekToColumnFamily(column_family_id, &seek_status)) {
       ++sequence_;
@@ -698,6 +718,9 @@ class MemTableInserter : public WriteBatch::Handler {
 
   CHECKED_STATUS DeleteImpl(uint32_t column_family_id, const Slice& key,
                             ValueType delete_type) {
+    if (SkipEntry()) {
+      return Status::OK();
+    }
     Status seek_status;
     if (!SeekToColumnFamily(column_family_id, &seek_status)) {
       ++sequence_;
@@ -746,6 +769,9 @@ class MemTableInserter : public WriteBatch::Handler {
   virtual CHECKED_STATUS MergeCF(uint32_t column_family_id, const Slice& key,
                                  const Slice& value) override {
     assert(!insert_flags_.Test(InsertFlag::kConcurrentMemtableWrites));
+    if (SkipEntry()) {
+      return Status::OK();
+    }
     Status seek_status;
     if (!SeekToColumnFamily(column_family_id, &seek_status)) {
       ++sequence_;
@@ -826,6 +852,9 @@ class MemTableInserter : public WriteBatch::Handler {
   }
 
   CHECKED_STATUS Frontiers(const UserFrontiers& frontiers) override {
+    if (entries_begin_ != 0) {
+      return Status::OK();
+    }
     Status seek_status;
     if (!SeekToColumnFamily(0, &seek_status)) {
       return seek_status;
@@ -851,6 +880,21 @@ class MemTableInserter : public WriteBatch::Handler {
   SequenceNumber CurrentSequenceNumber() {
     return sequence_;
   }
+
+  // Returns true if the current entry is out of the entries range, so it should be skipped.
+  // Skipped entries still consume their sequence numbers.
+  bool SkipEntry() {
+    const bool skip = entry_idx_ < entries_begin_ || entry_idx_ >= entries_end_;
+    ++entry_idx_;
+    if (skip) {
+      ++sequence_;
+    }
+    return skip;
+  }
+
+  size_t entries_begin_ = 0;
+  size_t entries_end_ = std::numeric_limits<size_t>::max();
+  size_t entry_idx_ = 0;
 };
 
 }  // namespace
@@ -892,6 +936,19 @@ Status WriteBatchInternal::InsertInto(const WriteBatch* batch,
   return batch->Iterate(&inserter);
 }
 
+Status WriteBatchInternal::InsertInto(const WriteBatch* batch,
+                                      SequenceNumber sequence,
+                                      size_t begin, size_t end,
+                                      ColumnFamilyMemTables* memtables,
+                                      FlushScheduler* flush_scheduler,
+                                      bool ignore_missing_column_families,
+                                      DB* db, InsertFlags insert_flags) {
+  MemTableInserter inserter(sequence, memtables, flush_scheduler, ignore_missing_column_families,
+                            0 /* log_number */, db, insert_flags);
+  inserter.SetEntriesRange(begin, end);
+  return batch->Iterate(&inserter);
+}
+
 void WriteBatchInternal::SetContents(WriteBatch* b, const Slice& contents) {
   DCHECK_GE(contents.size(), kHeader);
   b->rep_.assign(contents.cdata(), contents.size());
@@ -176,6 +176,17 @@ class WriteBatchInternal {
                            uint64_t log_number = 0, DB* db = nullptr,
                            InsertFlags insert_flags = InsertFlags());
 
+  // Inserts only entries of the batch with indexes in [begin, end), the entry with index i gets
+  // sequence + i sequence number. Frontiers of the batch are applied with the range that starts
+  // at the first entry. Used to insert a single batch into memtables by several threads.
+  static Status InsertInto(const WriteBatch* batch,
+                           SequenceNumber sequence,
+                           size_t begin, size_t end,
+                           ColumnFamilyMemTables* memtables,
+                           FlushScheduler* flush_scheduler,
+                           bool ignore_missing_column_families,
+                           DB* db, InsertFlags insert_flags);
+
   static void Append(WriteBatch* dst, const WriteBatch* src);
 
   // Returns the byte size of appending a WriteBatch with ByteSize
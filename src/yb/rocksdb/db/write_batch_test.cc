@@ -22,6 +22,7 @@
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
 #include <memory>
+#include <thread>
 
 #include "yb/rocksdb/db.h"
 
@@ -34,6 +35,7 @@
 #include "yb/rocksdb/utilities/write_batch_with_index.h"
 #include "yb/rocksdb/table/scoped_arena_iterator.h"
 #include "yb/rocksdb/util/logging.h"
+#include "yb/util/format.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/testharness.h"
 
@@ -489,6 +491,58 @@ TEST_F(WriteBatchTest, Continue) {
       handler.seen);
 }
 
+// Checks that ranges of a single batch could be inserted into the memtable by several threads.
+TEST_F(WriteBatchTest, ConcurrentInsertRanges) {
+  constexpr size_t kNumEntries = 100;
+  constexpr size_t kNumParts = 4;
+  constexpr SequenceNumber kSequence = 100;
+
+  WriteBatch batch;
+  for (size_t i = 0; i != kNumEntries; ++i) {
+    batch.Put(Slice(Format("k$0", 1000 + i)), Slice(Format("v$0", i)));
+  }
+
+  InternalKeyComparator cmp(BytewiseComparator());
+  Options options;
+  options.memtable_factory = std::make_shared<SkipListFactory>();
+  ImmutableCFOptions ioptions(options);
+  WriteBuffer wb(options.db_write_buffer_size);
+  MemTable* mem =
+      new MemTable(cmp, ioptions, MutableCFOptions(options, ioptions), &wb,
+                   kMaxSequenceNumber);
+  mem->Ref();
+
+  std::vector<std::thread> threads;
+  for (size_t part = 0; part != kNumParts; ++part) {
+    threads.emplace_back([&batch, mem, part] {
+      ColumnFamilyMemTablesDefault cf_mems_default(mem);
+      ASSERT_OK(WriteBatchInternal::InsertInto(
+          &batch, kSequence, kNumEntries * part / kNumParts, kNumEntries * (part + 1) / kNumParts,
+          &cf_mems_default, nullptr /* flush_scheduler */,
+          false /* ignore_missing_column_families */, nullptr /* db */,
+          InsertFlags{InsertFlag::kConcurrentMemtableWrites}));
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_EQ(kNumEntries, mem->num_entries());
+  ASSERT_EQ(kSequence, mem->GetFirstSequenceNumber());
+  Arena arena;
+  ScopedArenaIterator iter(mem->NewIterator(ReadOptions(), &arena));
+  size_t i = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++i) {
+    ParsedInternalKey ikey;
+    ASSERT_TRUE(ParseInternalKey(iter->key(), &ikey));
+    ASSERT_EQ(Format("k$0", 1000 + i), ikey.user_key.ToString());
+    ASSERT_EQ(kSequence + i, ikey.sequence);
+    ASSERT_EQ(Format("v$0", i), iter->value().ToString());
+  }
+  ASSERT_EQ(kNumEntries, i);
+  delete mem->Unref();
+}
+
 TEST_F(WriteBatchTest, PutGatherSlices) {
   WriteBatch batch;
   batch.Put(Slice("foo"), Slice("bar"));
@@ -46,6 +46,7 @@ namespace yb {
 
 class MemTracker;
 class PriorityThreadPool;
+class ThreadPool;
 
 }
 
@@ -68,6 +69,7 @@ class Snapshot;
 class TableFactory;
 class MemTableRepFactory;
 class TablePropertiesCollectorFactory;
+class UserFrontier;
 class RateLimiter;
 class SliceTransform;
 class Statistics;
@@ -168,9 +170,16 @@ struct CompressionOptions {
   int window_bits;
   int level;
   int strategy;
-  CompressionOptions() : window_bits(-14), level(-1), strategy(0) {}
-  CompressionOptions(int wbits, int _lev, int _strategy)
-      : window_bits(wbits), level(_lev), strategy(_strategy) {}
+  // Maximum size of dictionary used to prime the compression library. Data blocks of each SST file
+  // are buffered until enough of them are collected, then dictionary is built from their samples
+  // and stored in the file, so small and repetitive blocks compress better.
+  // ZSTD dictionary is trained when the library supports it, for Zlib and LZ4 raw samples are used.
+  // Dictionary is ignored for compression types that do not support it, e.g. Snappy.
+  // 0 - dictionary compression is disabled.
+  uint32_t max_dict_bytes;
+  CompressionOptions() : window_bits(-14), level(-1), strategy(0), max_dict_bytes(0) {}
+  CompressionOptions(int wbits, int _lev, int _strategy, uint32_t _max_dict_bytes = 0)
+      : window_bits(wbits), level(_lev), strategy(_strategy), max_dict_bytes(_max_dict_bytes) {}
 };
 
 enum UpdateStatus {    // Return status For inplace update callback
@@ -829,6 +838,9 @@ struct ColumnFamilyOptions {
 typedef std::function<yb::Result<bool>(const MemTable&)> MemTableFilter;
 using IteratorReplacer =
     std::function<InternalIterator*(InternalIterator*, Arena*, const Slice&)>;
+// Returns index in db_paths for compaction output, based on the largest user frontier of
+// compaction input files.
+using CompactionOutputPathSelector = std::function<uint32_t(const UserFrontier&)>;
 
 struct DBOptions {
   // Some functions that make it easier to optimize RocksDB
@@ -1101,6 +1113,11 @@ struct DBOptions {
   // Allow the OS to mmap file for reading sst tables. Default: false
   bool allow_mmap_reads;
 
+  // Read sst tables with O_DIRECT, so blocks cached in the block cache are not cached by the OS
+  // once again. Ignored if allow_mmap_reads is set, or the file system does not support O_DIRECT.
+  // Default: false
+  bool use_direct_reads = false;
+
   // Allow the OS to mmap file for writing.
   // DB::SyncWAL() only works if this is set to false.
   // Default: false
@@ -1262,6 +1279,17 @@ struct DBOptions {
   // Default: false
   bool allow_concurrent_memtable_write;
 
+  // If set, a single large write batch is split into up to max_memtable_insert_parts ranges of at
+  // least min_entries_per_memtable_insert_part entries, which are inserted into the memtable in
+  // parallel by the writing thread and threads of this pool. Batches are written one by one when
+  // they are applied by a single thread, so write batch groups do not help in such case.
+  // Independent of allow_concurrent_memtable_write, which also enables parallel insert of write
+  // batch groups, but requires the same memtable support (see CheckConcurrentWritesSupported).
+  // The writing thread blocks until all parts are inserted.
+  yb::ThreadPool* memtable_insert_pool = nullptr;
+  size_t max_memtable_insert_parts = 4;
+  size_t min_entries_per_memtable_insert_part = 512;
+
   // If true, threads synchronizing with the write batch group leader will
   // wait for up to write_thread_max_yield_usec before blocking on a mutex.
   // This can substantially improve throughput for concurrent workloads,
@@ -1350,6 +1378,12 @@ struct DBOptions {
   // Adds ability to modify iterator created for SST file.
   // For instance some additional filtering could be added.
   std::shared_ptr<IteratorReplacer> iterator_replacer;
+
+  // Allows to place output of universal compaction to a path other than the one chosen by
+  // target_size of db_paths. For instance files containing only old data could be moved to
+  // slower storage. Not invoked when some input file does not have user frontiers, and flush
+  // outputs always go to the first path.
+  std::shared_ptr<CompactionOutputPathSelector> compaction_output_path_selector;
 };
 
 // Options to control the behavior of a database (passed to DB::Open)
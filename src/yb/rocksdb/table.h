@@ -96,6 +96,11 @@ struct BlockBasedTableOptions {
   // Note: Fixed-size bloom filter data blocks are never pre-loaded.
   bool cache_index_and_filter_blocks = false;
 
+  // If true, filter blocks and index blocks are inserted into block cache with high priority, i.e.
+  // directly into the multi-touch part of the cache. So they are not evicted by data blocks that
+  // are read only once, for instance by scans.
+  bool cache_index_and_filter_blocks_with_high_priority = false;
+
   IndexType index_type = IndexType::kMultiLevelBinarySearch;
 
   // Influence the behavior when kHashSearch is used.
@@ -193,6 +198,13 @@ struct BlockBasedTableOptions {
   // Default: false
   bool skip_table_builder_flush = false;
 
+  // Thread pool used to load data blocks into the block cache ahead of sequential scans.
+  // Prefetching is disabled when it is not set or there is no block cache.
+  yb::ThreadPool* data_block_prefetch_pool = nullptr;
+
+  // Max number of data blocks that a sequential scan keeps prefetched ahead of its position.
+  size_t max_prefetched_data_blocks = 8;
+
   // We currently have three versions:
   // 0 -- This version is currently written out by all RocksDB's versions by
   // default.  Can be read by really old RocksDB's. Doesn't support changing
@@ -205,6 +217,9 @@ struct BlockBasedTableOptions {
   // encode compressed blocks with LZ4, BZip2 and Zlib compression. If you
   // don't plan to run RocksDB before version 3.10, you should probably use
   // this.
+  // 3 -- Same as 2, but files could contain data blocks compressed with a dictionary, see
+  // CompressionOptions::max_dict_bytes. Written instead of version 2 to such files, so releases
+  // that do not support dictionaries reject them instead of failing to uncompress data blocks.
   // This option only affects newly written tables. When reading exising tables,
   // the information about version is read from the footer.
   uint32_t format_version = 2;
@@ -222,6 +237,10 @@ struct BlockBasedTablePropertyNames {
   static const char kPrefixFiltering[];
 };
 
+// Id of the child of block based table mem tracker, that tracks memory used by filter blocks and
+// filter index.
+extern const char kFilterBlocksMemTrackerId[];
+
 // Create default block based table factory.
 extern TableFactory* NewBlockBasedTableFactory(
     const BlockBasedTableOptions& table_options = BlockBasedTableOptions());
@@ -132,9 +132,33 @@ void BlockIter::Seek(const Slice& target) {
   bool ok = false;
   if (prefix_index_) {
     ok = PrefixSeek(target, &index);
+  } else if (hash_index_) {
+    ok = HashSeek(target, &index);
   } else {
-    ok = hash_index_ ? HashSeek(target, &index)
-      : BinarySeek(target, 0, num_restarts_ - 1, &index);
+    uint32_t left = 0;
+    if (Valid() && status_.ok()) {
+      // DocDB mostly seeks forward to nearby keys, e.g. to skip older versions of a column or to
+      // go to the next column. When the target is after the current entry, the restarts before
+      // the current one could be excluded from the search, and when it is within the current
+      // restart interval we just continue the linear search from the current entry.
+      const int cmp = Compare(key_.GetKey(), target);
+      if (cmp == 0) {
+        return;
+      }
+      if (cmp < 0) {
+        if (restart_index_ + 1 == num_restarts_ ||
+            CompareBlockKey(restart_index_ + 1, target) > 0) {
+          if (!status_.ok()) {
+            return;
+          }
+          while (ParseNextKey() && Compare(key_.GetKey(), target) < 0) {
+          }
+          return;
+        }
+        left = restart_index_ + 1;
+      }
+    }
+    ok = BinarySeek(target, left, num_restarts_ - 1, &index);
   }
 
   if (!ok) {
@@ -439,8 +463,33 @@ yb::Result<Slice> Block::GetMiddleKey() const {
     return STATUS(Incomplete, "Empty block");
   }
 
-  const auto restart_idx = (NumRestarts() - 1) / 2;
+  return GetRestartKey((NumRestarts() - 1) / 2);
+}
+
+yb::Result<std::vector<Slice>> Block::GetSplitKeys(size_t num_parts) const {
+  if (size_ < kMinBlockSize) {
+    return BadBlockContentsError();
+  } else if (size_ == kMinBlockSize) {
+    return STATUS(Incomplete, "Empty block");
+  }
+
+  const uint64_t num_restarts = NumRestarts();
+  std::vector<Slice> result;
+  result.reserve(num_parts > 0 ? num_parts - 1 : 0);
+  uint64_t prev_restart_idx = 0;
+  for (uint64_t part = 1; part < num_parts; ++part) {
+    const auto restart_idx = num_restarts * part / num_parts;
+    // The first restart key is the beginning of the block, so it does not split anything.
+    if (restart_idx == prev_restart_idx) {
+      continue;
+    }
+    result.push_back(VERIFY_RESULT(GetRestartKey(static_cast<uint32_t>(restart_idx))));
+    prev_restart_idx = restart_idx;
+  }
+  return result;
+}
 
+yb::Result<Slice> Block::GetRestartKey(uint32_t restart_idx) const {
   const auto entry_offset = DecodeFixed32(data_ + restart_offset_ + restart_idx * sizeof(uint32_t));
   uint32_t shared, non_shared, value_length;
   const char* key_ptr = DecodeEntry(
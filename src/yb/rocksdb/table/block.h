@@ -95,7 +95,14 @@ class Block {
   // points description).
   yb::Result<Slice> GetMiddleKey() const;
 
+  // Returns up to num_parts - 1 restart keys from this block, which divide it into num_parts parts
+  // with roughly the same number of restart intervals. Keys are returned in ascending order.
+  yb::Result<std::vector<Slice>> GetSplitKeys(size_t num_parts) const;
+
  private:
+  // Returns key of the entry at the specified restart point.
+  yb::Result<Slice> GetRestartKey(uint32_t restart_idx) const;
+
   BlockContents contents_;
   const char* data_;            // contents_.data.data()
   size_t size_;                 // contents_.data.size()
@@ -27,11 +27,13 @@
 #include <inttypes.h>
 #include <stdio.h>
 
+#include <algorithm>
 #include <map>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "yb/rocksdb/db/dbformat.h"
 
@@ -110,6 +112,7 @@ bool GoodCompressionRatio(size_t compressed_size, size_t raw_size) {
 Slice CompressBlock(const Slice& raw,
                     const CompressionOptions& compression_options,
                     CompressionType* type, uint32_t format_version,
+                    const Slice& compression_dict,
                     std::string* compressed_output) {
   if (*type == kNoCompression) {
     return raw;
@@ -129,7 +132,7 @@ Slice CompressBlock(const Slice& raw,
       if (Zlib_Compress(
               compression_options,
               GetCompressFormatForVersion(kZlibCompression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -147,7 +150,7 @@ Slice CompressBlock(const Slice& raw,
       if (LZ4_Compress(
               compression_options,
               GetCompressFormatForVersion(kLZ4Compression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -156,14 +159,14 @@ Slice CompressBlock(const Slice& raw,
       if (LZ4HC_Compress(
               compression_options,
               GetCompressFormatForVersion(kLZ4HCCompression, format_version),
-              raw.cdata(), raw.size(), compressed_output) &&
+              raw.cdata(), raw.size(), compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
       break;     // fall back to no compression.
     case kZSTDNotFinalCompression:
       if (ZSTD_Compress(compression_options, raw.cdata(), raw.size(),
-                        compressed_output) &&
+                        compressed_output, compression_dict) &&
           GoodCompressionRatio(compressed_output->size(), raw.size())) {
         return *compressed_output;
       }
@@ -299,6 +302,21 @@ struct BlockBasedTableBuilder::Rep {
   std::string compressed_output;
   std::unique_ptr<FlushBlockPolicy> flush_block_policy;
 
+  // Data block which is not written yet, because compression dictionary is not built.
+  struct BufferedDataBlock {
+    std::string contents;
+    std::string last_key;
+    std::string next_block_first_key;
+  };
+
+  // When compression dictionary is enabled, data blocks are buffered until there are enough
+  // samples to build the dictionary. Then buffered blocks are written compressed with the
+  // dictionary, and the following blocks are written without buffering.
+  bool buffer_data_blocks = false;
+  std::vector<BufferedDataBlock> buffered_data_blocks;
+  size_t buffered_data_size = 0;
+  std::string compression_dict;
+
   std::vector<std::unique_ptr<IntTblPropCollector>> table_properties_collectors;
 
   yb::MemTrackerPtr mem_tracker;
@@ -371,6 +389,15 @@ BlockBasedTableBuilder::Rep::Rep(
       flush_block_policy(
           table_options.flush_block_policy_factory->NewFlushBlockPolicy(
               table_options, data_block_builder)) {
+  // Block-based filter and hash index are built per data block while it is being added, so they
+  // could not be used with buffered data blocks.
+  // Files with dictionary are marked by footer version, that is only written with the current block
+  // compression format.
+  buffer_data_blocks = compression_opts.max_dict_bytes > 0 &&
+                       CompressionDictSupported(compression_type) &&
+                       table_options.format_version >= 2 &&
+                       filter_type != FilterType::kBlockBasedFilter &&
+                       table_options.index_type != IndexType::kHashSearch;
   if (_ioptions.mem_tracker) {
     mem_tracker = yb::MemTracker::FindOrCreateTracker(
         "BlockBasedTableBuilder", _ioptions.mem_tracker);
@@ -487,14 +514,38 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   Rep* const r = rep_;
   assert(!r->closed);
   if (!ok()) return;
-  size_t data_block_size = 0;
 
+  if (r->buffer_data_blocks) {
+    if (!r->data_block_builder.empty()) {
+      Rep::BufferedDataBlock block;
+      block.contents = r->data_block_builder.Finish().ToBuffer();
+      r->data_block_builder.Reset();
+      block.last_key = r->last_key;
+      block.next_block_first_key = next_block_first_key.ToBuffer();
+      r->buffered_data_size += block.contents.size();
+      r->buffered_data_blocks.push_back(std::move(block));
+    }
+    if (next_block_first_key.empty() ||
+        r->buffered_data_size >=
+            kCompressionDictSamplesFactor * r->compression_opts.max_dict_bytes) {
+      ReleaseBufferedDataBlocks();
+    }
+    return;
+  }
+
+  size_t data_block_size = 0;
   if (!r->data_block_builder.empty()) {
     data_block_size = WriteBlock(&r->data_block_builder, &r->data_pending_handle,
-        r->data_writer.get());
+        r->data_writer.get(), r->compression_dict);
   }
   if (!ok()) return;
 
+  DataBlockWritten(data_block_size, &r->last_key, next_block_first_key);
+}
+
+void BlockBasedTableBuilder::DataBlockWritten(
+    size_t data_block_size, std::string* last_key, const Slice& next_block_first_key) {
+  Rep* const r = rep_;
   if (!r->table_options.skip_table_builder_flush) {
     r->status = r->data_writer->writer->Flush();
   }
@@ -515,7 +566,7 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   // "the r" as the key for the index block entry since it is >= all
   // entries in the first block and < all entries in subsequent
   // blocks.
-  r->data_index_builder->AddIndexEntry(&r->last_key,
+  r->data_index_builder->AddIndexEntry(last_key,
       next_block_first_key.empty() ? nullptr : &next_block_first_key,
       r->data_pending_handle);
   while (r->data_index_builder->ShouldFlush()) {
@@ -534,6 +585,60 @@ void BlockBasedTableBuilder::FlushDataBlock(const Slice& next_block_first_key) {
   }
 }
 
+void BlockBasedTableBuilder::ReleaseBufferedDataBlocks() {
+  Rep* const r = rep_;
+  r->buffer_data_blocks = false;
+  BuildCompressionDict();
+
+  auto buffered_data_blocks = std::move(r->buffered_data_blocks);
+  r->buffered_data_blocks.clear();
+  r->buffered_data_size = 0;
+  for (auto& block : buffered_data_blocks) {
+    const size_t data_block_size = WriteBlock(
+        block.contents, &r->data_pending_handle, r->data_writer.get(), r->compression_dict);
+    if (!ok()) return;
+    DataBlockWritten(data_block_size, &block.last_key, block.next_block_first_key);
+    if (!ok()) return;
+    // Release memory as soon as block is written.
+    block = Rep::BufferedDataBlock();
+  }
+}
+
+void BlockBasedTableBuilder::BuildCompressionDict() {
+  Rep* const r = rep_;
+  const auto& blocks = r->buffered_data_blocks;
+  const size_t max_dict_bytes = r->compression_opts.max_dict_bytes;
+  if (blocks.empty() || max_dict_bytes == 0) {
+    return;
+  }
+
+  if (r->compression_type == kZSTDNotFinalCompression) {
+    std::string samples;
+    std::vector<size_t> sample_lens;
+    samples.reserve(r->buffered_data_size);
+    sample_lens.reserve(blocks.size());
+    for (const auto& block : blocks) {
+      samples.append(block.contents);
+      sample_lens.push_back(block.contents.size());
+    }
+    r->compression_dict = ZSTD_TrainDictionary(samples, sample_lens, max_dict_bytes);
+    if (!r->compression_dict.empty()) {
+      return;
+    }
+  }
+
+  // Other compression libraries use dictionary as already seen data, so it is composed of
+  // prefixes of data blocks evenly sampled from the buffered ones.
+  const size_t num_samples = std::min(
+      blocks.size(), std::max<size_t>(max_dict_bytes / kMinCompressionDictSampleSize, 1));
+  const size_t sample_size = max_dict_bytes / num_samples;
+  r->compression_dict.reserve(max_dict_bytes);
+  for (size_t i = 0; i != num_samples; ++i) {
+    const auto& contents = blocks[i * blocks.size() / num_samples].contents;
+    r->compression_dict.append(contents.data(), std::min(sample_size, contents.size()));
+  }
+}
+
 void BlockBasedTableBuilder::FlushFilterBlock(const Slice* const next_block_first_filter_key) {
   Rep* const r = rep_;
   assert(!r->closed);
@@ -564,15 +669,17 @@ void BlockBasedTableBuilder::FlushFilterBlock(const Slice* const next_block_firs
 
 size_t BlockBasedTableBuilder::WriteBlock(BlockBuilder* block,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
-  size_t block_size = WriteBlock(block->Finish(), handle, writer_info);
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const Slice& compression_dict) {
+  size_t block_size = WriteBlock(block->Finish(), handle, writer_info, compression_dict);
   block->Reset();
   return block_size;
 }
 
 size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
                                           BlockHandle* handle,
-                                          FileWriterWithOffsetAndCachePrefix* writer_info) {
+                                          FileWriterWithOffsetAndCachePrefix* writer_info,
+                                          const Slice& compression_dict) {
   // File format contains a sequence of blocks where each block has:
   //    block_data: uint8[n]
   //    type: uint8
@@ -585,7 +692,8 @@ size_t BlockBasedTableBuilder::WriteBlock(const Slice& raw_block_contents,
   if (raw_block_contents.size() < kCompressionSizeLimit) {
     block_contents =
         CompressBlock(raw_block_contents, r->compression_opts, &type,
-                      r->table_options.format_version, &r->compressed_output);
+                      r->table_options.format_version, compression_dict,
+                      &r->compressed_output);
   } else {
     RecordTick(r->ioptions.statistics, NUMBER_BLOCK_NOT_COMPRESSED);
     type = kNoCompression;
@@ -703,7 +811,7 @@ Status BlockBasedTableBuilder::InsertBlockInCache(const Slice& block_contents,
 Status BlockBasedTableBuilder::Finish() {
   Rep* r = rep_;
   Slice end_slice;
-  if (!r->data_block_builder.empty()) {
+  if (!r->data_block_builder.empty() || !r->buffered_data_blocks.empty()) {
     FlushDataBlock(end_slice);  // no more data block
   }
   if (r->filter_block_builder != nullptr) {
@@ -732,6 +840,15 @@ Status BlockBasedTableBuilder::Finish() {
     meta_index_builder.Add(item.first, block_handle);
   }
 
+  if (ok() && !r->compression_dict.empty()) {
+    // Dictionary is stored uncompressed, since it is required to decompress data blocks.
+    BlockHandle compression_dict_block_handle;
+    WriteRawBlock(r->compression_dict, kNoCompression, &compression_dict_block_handle,
+        r->metadata_writer.get());
+    meta_index_builder.Add(
+        block_based_table::kCompressionDictBlock, compression_dict_block_handle);
+  }
+
   if (ok()) {
     if (r->filter_block_builder != nullptr) {
       // Add mapping from "<filter_block_prefix>.Name" to location of either filter block or
@@ -828,7 +945,8 @@ Status BlockBasedTableBuilder::Finish() {
         r->table_options.format_version != 0);
     Footer footer(legacy ? kLegacyBlockBasedTableMagicNumber
             : kBlockBasedTableMagicNumber,
-        r->table_options.format_version);
+        r->compression_dict.empty() ? r->table_options.format_version
+                                    : kCompressionDictFormatVersion);
     footer.set_metaindex_handle(meta_index_block_handle);
     footer.set_index_handle(r->last_index_block_handle);
     footer.set_checksum(r->table_options.checksum);
@@ -854,8 +972,9 @@ uint64_t BlockBasedTableBuilder::NumEntries() const {
 }
 
 uint64_t BlockBasedTableBuilder::TotalFileSize() const {
-  return rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
-      rep_->metadata_writer->offset;
+  // Buffered data blocks are accounted uncompressed, so output file could be cut while buffering.
+  return (rep_->is_split_sst() ? rep_->metadata_writer->offset + rep_->data_writer->offset :
+      rep_->metadata_writer->offset) + rep_->buffered_data_size;
 }
 
 uint64_t BlockBasedTableBuilder::BaseFileSize() const {
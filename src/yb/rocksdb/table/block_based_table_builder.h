@@ -109,10 +109,12 @@ class BlockBasedTableBuilder : public TableBuilder {
   // Call block's Finish() method and then write the finalize block contents to
   // file. Returns number of bytes written to file.
   size_t WriteBlock(BlockBuilder* block, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const Slice& compression_dict = Slice());
   // Directly write block content to the file. Returns number of bytes written to file.
   size_t WriteBlock(const Slice& block_contents, BlockHandle* handle,
-      FileWriterWithOffsetAndCachePrefix* writer_info);
+      FileWriterWithOffsetAndCachePrefix* writer_info,
+      const Slice& compression_dict = Slice());
   size_t WriteRawBlock(const Slice& data, CompressionType, BlockHandle* handle,
       FileWriterWithOffsetAndCachePrefix* writer_info);
   Status InsertBlockInCache(const Slice& block_contents,
@@ -130,6 +132,16 @@ class BlockBasedTableBuilder : public TableBuilder {
   // REQUIRES: Finish(), Abandon() have not been called.
   void FlushDataBlock(const Slice& next_block_first_key);
 
+  // Updates properties and data index after data block, which ends with last_key, has been
+  // written to disk.
+  void DataBlockWritten(
+      size_t data_block_size, std::string* last_key, const Slice& next_block_first_key);
+
+  // Builds compression dictionary from buffered data blocks and writes them to disk.
+  void ReleaseBufferedDataBlocks();
+
+  void BuildCompressionDict();
+
   // Flush the current filter block into disk. next_block_first_filter_key should be nullptr if this
   // is the last block written to disk.
   // REQUIRES: Finish(), Abandon() have not been called.
@@ -139,6 +151,13 @@ class BlockBasedTableBuilder : public TableBuilder {
   // uncompressed size is bigger than kCompressionSizeLimit, don't compress it
   const uint64_t kCompressionSizeLimit = std::numeric_limits<int>::max();
 
+  // Data blocks are buffered until their total size reaches max_dict_bytes multiplied by this
+  // factor, so the dictionary is built from enough samples.
+  static constexpr size_t kCompressionDictSamplesFactor = 100;
+
+  // Minimal size of data block prefix to be used as a compression dictionary sample.
+  static constexpr size_t kMinCompressionDictSampleSize = 1024;
+
   // No copying allowed
   BlockBasedTableBuilder(const BlockBasedTableBuilder&) = delete;
   void operator=(const BlockBasedTableBuilder&) = delete;
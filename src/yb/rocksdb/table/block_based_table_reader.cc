@@ -23,6 +23,9 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <condition_variable>
+#include <limits>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <cinttypes>
@@ -67,6 +70,7 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/string_util.h"
+#include "yb/util/threadpool.h"
 
 namespace rocksdb {
 
@@ -200,6 +204,10 @@ struct BlockBasedTable::Rep {
     } else if (ioptions.mem_tracker) {
       mem_tracker = yb::MemTracker::FindOrCreateTracker("BlockBasedTable", ioptions.mem_tracker);
     }
+    if (mem_tracker) {
+      filter_mem_tracker = yb::MemTracker::FindOrCreateTracker(
+          kFilterBlocksMemTrackerId, mem_tracker);
+    }
   }
 
   const ImmutableCFOptions& ioptions;
@@ -218,7 +226,10 @@ struct BlockBasedTable::Rep {
   std::mutex data_index_reader_mutex;
   yb::AtomicUniquePtr<IndexReader> data_index_reader;
   unique_ptr<BlockEntryIteratorState> data_index_iterator_state;
-  unique_ptr<IndexReader> filter_index_reader;
+  // Index of fixed-size bloom filter blocks, loaded on first filter access, so tables that are not
+  // read do not keep it in memory.
+  std::mutex filter_index_reader_mutex;
+  yb::AtomicUniquePtr<IndexReader> filter_index_reader;
   unique_ptr<FilterBlockReader> filter;
 
   FilterType filter_type;
@@ -240,11 +251,24 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+  // Child of mem_tracker, that tracks memory used by filter blocks and filter index.
+  yb::MemTrackerPtr filter_mem_tracker;
+
+  // Dictionary data blocks were compressed with, empty if no dictionary was used.
+  BlockContents compression_dict_block;
+
+  Slice DataBlockCompressionDict(BlockType block_type) const {
+    return block_type == BlockType::kData ? compression_dict_block.data : Slice();
+  }
 };
 
-// BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
-// to BlockBasedTable. It is used by TwoLevelIterator and MultiLevelIterator to call BlockBasedTable
-// functions in order to check if prefix may match or to create a secondary iterator.
+// BlockEntryIteratorState is used as an adapter to BlockBasedTable. It is used by TwoLevelIterator
+// and MultiLevelIterator to call BlockBasedTable functions in order to check if prefix may match or
+// to create a secondary iterator.
+//
+// For data blocks it also implements readahead: once a scan reads several adjacent data blocks in
+// a row, following data blocks are loaded into the block cache by data_block_prefetch_pool, so
+// they are already cached when the scan reaches them.
 class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
  public:
   BlockEntryIteratorState(
@@ -254,7 +278,20 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         table_(table),
         read_options_(read_options),
         skip_filters_(skip_filters),
-        block_type_(block_type) {}
+        block_type_(block_type),
+        prefetch_pool_(PrefetchPool(*table, read_options, block_type)) {}
+
+  ~BlockEntryIteratorState() {
+    if (!prefetch_context_) {
+      return;
+    }
+    // Prefetch tasks use the table, so tasks that have not started yet are cancelled, and the
+    // ones that are reading a block now are waited for while the table is still pinned by the
+    // iterator.
+    std::unique_lock<std::mutex> lock(prefetch_context_->mutex);
+    prefetch_context_->cancelled = true;
+    prefetch_context_->cond.wait(lock, [this] { return prefetch_context_->running == 0; });
+  }
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
@@ -267,7 +304,105 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
     return table_->PrefixMayMatch(internal_key);
   }
 
+  void OnNewSecondaryIterator(const Slice& index_key, const Slice& index_value) override {
+    if (!prefetch_pool_) {
+      return;
+    }
+    BlockHandle handle;
+    Slice input = index_value;
+    if (!handle.DecodeFrom(&input).ok()) {
+      return;
+    }
+    const bool sequential = handle.offset() == next_block_offset_;
+    next_block_offset_ = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (!sequential) {
+      sequential_blocks_ = 0;
+      prefetched_blocks_ = 0;
+      prefetch_iter_positioned_ = false;
+      return;
+    }
+    if (prefetched_blocks_ > 0) {
+      --prefetched_blocks_;
+    }
+    if (++sequential_blocks_ < kMinSequentialBlocksForPrefetch) {
+      return;
+    }
+    // Refill the readahead window when half of it is consumed, to submit blocks in batches.
+    const auto max_blocks = table_->rep_->table_options.max_prefetched_data_blocks;
+    if (prefetched_blocks_ * 2 > max_blocks) {
+      return;
+    }
+    if (!prefetch_iter_positioned_) {
+      if (!prefetch_index_iter_) {
+        prefetch_index_iter_.reset(table_->NewIndexIterator(read_options_));
+      }
+      prefetch_index_iter_->Seek(index_key);
+      if (prefetch_index_iter_->Valid()) {
+        prefetch_index_iter_->Next();
+      }
+      prefetch_iter_positioned_ = true;
+    }
+    while (prefetched_blocks_ < max_blocks && prefetch_index_iter_->Valid()) {
+      SubmitPrefetch(prefetch_index_iter_->value());
+      ++prefetched_blocks_;
+      prefetch_index_iter_->Next();
+    }
+  }
+
  private:
+  // Number of adjacent data blocks that should be read before readahead is started.
+  static constexpr size_t kMinSequentialBlocksForPrefetch = 2;
+
+  static yb::ThreadPool* PrefetchPool(
+      const BlockBasedTable& table, const ReadOptions& read_options, BlockType block_type) {
+    const auto& table_options = table.rep_->table_options;
+    if (block_type != BlockType::kData || table_options.block_cache == nullptr ||
+        table_options.max_prefetched_data_blocks == 0 || !read_options.fill_cache ||
+        read_options.read_tier == kBlockCacheTier ||
+        table.rep_->index_type == IndexType::kHashSearch) {
+      return nullptr;
+    }
+    return table_options.data_block_prefetch_pool;
+  }
+
+  // Shared by the iterator state and its prefetch tasks, so tasks that are still queued when the
+  // iterator is destroyed could find out that they are cancelled.
+  struct PrefetchContext {
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool cancelled = false;
+    // Number of tasks that are reading a block now.
+    size_t running = 0;
+  };
+
+  void SubmitPrefetch(const Slice& index_value) {
+    if (!prefetch_context_) {
+      prefetch_context_ = std::make_shared<PrefetchContext>();
+    }
+    ReadOptions read_options;
+    read_options.verify_checksums = read_options_.verify_checksums;
+    read_options.query_id = read_options_.query_id;
+    WARN_NOT_OK(prefetch_pool_->SubmitFunc(
+        [table = table_, read_options, index_value = index_value.ToBuffer(),
+         context = prefetch_context_] {
+      {
+        std::lock_guard<std::mutex> lock(context->mutex);
+        if (context->cancelled) {
+          return;
+        }
+        ++context->running;
+      }
+      {
+        BlockIter biter;
+        table->NewDataBlockIterator(read_options, index_value, BlockType::kData, &biter);
+      }
+      std::lock_guard<std::mutex> lock(context->mutex);
+      if (--context->running == 0) {
+        context->cond.notify_all();
+      }
+    }), "Failed to submit data block prefetch");
+  }
+
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
   // after iterator is deleted.
@@ -275,8 +410,19 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
-};
 
+  yb::ThreadPool* const prefetch_pool_;
+  // Offset of the data block that follows the last accessed one.
+  uint64_t next_block_offset_ = std::numeric_limits<uint64_t>::max();
+  size_t sequential_blocks_ = 0;
+  // Number of data blocks that were submitted for prefetch and not reached by the scan yet.
+  size_t prefetched_blocks_ = 0;
+  // Separate index iterator that points to the next data block to prefetch.
+  std::unique_ptr<InternalIterator> prefetch_index_iter_;
+  bool prefetch_iter_positioned_ = false;
+
+  std::shared_ptr<PrefetchContext> prefetch_context_;
+};
 
 class BlockBasedTable::IndexIteratorHolder {
  public:
@@ -415,6 +561,8 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
 
   RETURN_NOT_OK(new_table->SetupFilter(meta_iter.get()));
 
+  RETURN_NOT_OK(new_table->ReadCompressionDictBlock(meta_iter.get()));
+
   if (data_index_load_mode == DataIndexLoadMode::PRELOAD_ON_OPEN) {
     // Will use block cache for data index access?
     if (table_options.cache_index_and_filter_blocks) {
@@ -436,12 +584,6 @@ Status BlockBasedTable::Open(const ImmutableCFOptions& ioptions,
   if (prefetch_filter == PrefetchFilter::YES) {
     // pre-fetching of blocks is turned on
     // NOTE: Table reader objects are cached in table cache (table_cache.cc).
-    if (rep->filter_policy && rep->filter_type == FilterType::kFixedSizeFilter) {
-      // TODO: may be put it in block cache instead of table reader in case
-      // table_options.cache_index_and_filter_blocks is set?
-      RETURN_NOT_OK(new_table->CreateFilterIndexReader(&rep->filter_index_reader));
-    }
-
     // Will use block cache for filter blocks access?
     if (table_options.cache_index_and_filter_blocks) {
       assert(table_options.block_cache != nullptr);
@@ -553,6 +695,18 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
   return Status::OK();
 }
 
+Status BlockBasedTable::ReadCompressionDictBlock(InternalIterator* meta_iter) {
+  BlockHandle handle;
+  if (!FindMetaBlock(meta_iter, block_based_table::kCompressionDictBlock, &handle).ok()) {
+    // Data blocks were compressed without dictionary.
+    return Status::OK();
+  }
+  return ReadBlockContents(
+      rep_->base_reader_with_cache_prefix->reader.get(), rep_->footer, ReadOptions::kDefault,
+      handle, &rep_->compression_dict_block, rep_->ioptions.env, rep_->mem_tracker,
+      false /* do_uncompress */);
+}
+
 Status BlockBasedTable::SetupFilter(InternalIterator* meta_iter) {
   // Find filter handle and filter type.
   if (!rep_->filter_policy) {
@@ -668,8 +822,9 @@ size_t BlockBasedTable::ApproximateMemoryUsage() const {
   if (rep_->filter) {
     usage += rep_->filter->ApproximateMemoryUsage();
   }
-  if (rep_->filter_index_reader) {
-    usage += rep_->filter_index_reader->ApproximateMemoryUsage();
+  IndexReader* filter_index_reader = rep_->filter_index_reader.get(std::memory_order_relaxed);
+  if (filter_index_reader) {
+    usage += filter_index_reader->ApproximateMemoryUsage();
   }
   IndexReader* data_index_reader = rep_->data_index_reader.get(std::memory_order_relaxed);
   if (data_index_reader) {
@@ -738,7 +893,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -782,7 +937,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
   // Retrieve the uncompressed contents into a new buffer
   BlockContents contents;
   s = UncompressBlockContents(compressed_block->data(), compressed_block->size(), &contents,
-                              format_version, mem_tracker);
+                              format_version, mem_tracker, compression_dict);
 
   // Insert uncompressed block into block cache
   if (s.ok()) {
@@ -810,7 +965,7 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -819,7 +974,7 @@ Status BlockBasedTable::PutDataBlockToCache(
   BlockContents contents;
   if (raw_block->compression_type() != kNoCompression) {
     s = UncompressBlockContents(raw_block->data(), raw_block->size(), &contents,
-                                format_version, mem_tracker);
+                                format_version, mem_tracker, compression_dict);
   }
   if (!s.ok()) {
     delete raw_block;
@@ -864,12 +1019,34 @@ Status BlockBasedTable::PutDataBlockToCache(
   return s;
 }
 
-Status BlockBasedTable::CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader) {
+Status BlockBasedTable::CreateFilterIndexReader(
+    std::unique_ptr<IndexReader>* filter_index_reader) const {
   auto base_file_reader = rep_->base_reader_with_cache_prefix->reader.get();
   auto env = rep_->ioptions.env;
   auto footer = rep_->footer;
   return BinarySearchIndexReader::Create(base_file_reader, footer, rep_->filter_handle, env,
-      SharedBytewiseComparator(), filter_index_reader, rep_->mem_tracker);
+      SharedBytewiseComparator(), filter_index_reader, rep_->filter_mem_tracker);
+}
+
+yb::Result<IndexReader*> BlockBasedTable::GetFilterIndexReader() const {
+  auto* filter_index_reader = rep_->filter_index_reader.get(std::memory_order_acquire);
+  if (filter_index_reader) {
+    return filter_index_reader;
+  }
+  std::lock_guard<std::mutex> lock(rep_->filter_index_reader_mutex);
+  filter_index_reader = rep_->filter_index_reader.get(std::memory_order_relaxed);
+  if (!filter_index_reader) {
+    std::unique_ptr<IndexReader> filter_index_reader_holder;
+    RETURN_NOT_OK(CreateFilterIndexReader(&filter_index_reader_holder));
+    filter_index_reader = filter_index_reader_holder.release();
+    rep_->filter_index_reader.reset(filter_index_reader, std::memory_order_acq_rel);
+  }
+  return filter_index_reader;
+}
+
+QueryId BlockBasedTable::GetIndexAndFilterCacheQueryId(QueryId query_id) const {
+  return rep_->table_options.cache_index_and_filter_blocks_with_high_priority
+      ? kInMultiTouchId : query_id;
 }
 
 FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_handle, Rep* rep,
@@ -882,7 +1059,7 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
   BlockContents block;
   if (!ReadBlockContents(
            rep->base_reader_with_cache_prefix->reader.get(), rep->footer, ReadOptions::kDefault,
-           filter_handle, &block, rep->ioptions.env, rep->mem_tracker, false).ok()) {
+           filter_handle, &block, rep->ioptions.env, rep->filter_mem_tracker, false).ok()) {
     // Error reading the block
     return nullptr;
   }
@@ -923,8 +1100,9 @@ FilterBlockReader* BlockBasedTable::ReadFilterBlock(const BlockHandle& filter_ha
 Status BlockBasedTable::GetFixedSizeFilterBlockHandle(const Slice& filter_key,
     BlockHandle* filter_block_handle) const {
   // Determine block of fixed-size bloom filter using filter index.
+  auto* filter_index_reader = VERIFY_RESULT(GetFilterIndexReader());
   BlockIter fiter;
-  rep_->filter_index_reader->NewIterator(&fiter,
+  filter_index_reader->NewIterator(&fiter,
       // Following parameters are ignored by BinarySearchIndexReader which we use as
       // filter_index_reader.
       nullptr /* index_iterator_state */, true /* total_order_seek */);
@@ -1028,8 +1206,8 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
     filter = ReadFilterBlock(*filter_block_handle, rep_, &filter_size);
     if (filter != nullptr) {
       assert(filter_size > 0);
-      Status s = block_cache->Insert(filter_block_cache_key, query_id,
-                                     filter, filter_size,
+      Status s = block_cache->Insert(filter_block_cache_key,
+                                     GetIndexAndFilterCacheQueryId(query_id), filter, filter_size,
                                      &DeleteCachedEntry<FilterBlockReader>, &cache_handle,
                                      statistics);
       if (!s.ok()) {
@@ -1092,8 +1270,9 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
       std::unique_ptr<IndexReader> index_reader_unique;
       RETURN_NOT_OK(CreateDataBlockIndexReader(&index_reader_unique));
       RETURN_NOT_OK(block_cache->Insert(
-          key, read_options.query_id, index_reader_unique.get(), index_reader_unique->usable_size(),
-          &DeleteCachedEntry<IndexReader>, &cache_handle, statistics));
+          key, GetIndexAndFilterCacheQueryId(read_options.query_id), index_reader_unique.get(),
+          index_reader_unique->usable_size(), &DeleteCachedEntry<IndexReader>, &cache_handle,
+          statistics));
       assert(cache_handle);
       index_reader = index_reader_unique.release();
     }
@@ -1171,9 +1350,22 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
   }
 
   FileReaderWithCachePrefix* reader = GetBlockReader(block_type);
+  const Slice compression_dict = rep_->DataBlockCompressionDict(block_type);
 
   // If either block cache is enabled, we'll try to read from it.
   if (block_cache != nullptr || block_cache_compressed != nullptr) {
+    // Lower level blocks of multi-level index are cached with the same priority as filter blocks.
+    const ReadOptions* cache_read_options = &ro;
+    ReadOptions index_read_options;
+    if (block_type == BlockType::kIndex) {
+      const auto query_id = GetIndexAndFilterCacheQueryId(ro.query_id);
+      if (query_id != ro.query_id) {
+        index_read_options = ro;
+        index_read_options.query_id = query_id;
+        cache_read_options = &index_read_options;
+      }
+    }
+
     Statistics* statistics = rep_->ioptions.statistics;
     char cache_key[block_based_table::kCacheKeyBufferSize];
     char compressed_cache_key[block_based_table::kCacheKeyBufferSize];
@@ -1190,8 +1382,8 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     }
 
     s = GetDataBlockFromCache(
-        key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        key, ckey, block_cache, block_cache_compressed, statistics, *cache_read_options, &block,
+        rep_->table_options.format_version, block_type, rep_->mem_tracker, compression_dict);
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
@@ -1199,13 +1391,14 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
         s = block_based_table::ReadBlockFromFile(
             reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            rep_->mem_tracker, block_cache_compressed == nullptr, compression_dict);
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
-                                ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                *cache_read_options, statistics, &block, raw_block.release(),
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                compression_dict);
       }
     }
   }
@@ -1224,7 +1417,7 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
     std::unique_ptr<Block> block_value;
     s = block_based_table::ReadBlockFromFile(
         reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        rep_->mem_tracker, true /* do_uncompress */, compression_dict);
     if (s.ok()) {
       block.value = block_value.release();
     }
@@ -1533,7 +1726,8 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
   Slice ckey;
 
   s = GetDataBlockFromCache(cache_key, ckey, block_cache, nullptr, nullptr, options, &block,
-      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker,
+      rep_->DataBlockCompressionDict(BlockType::kData));
   assert(s.ok());
   bool in_cache = block.value != nullptr;
   if (in_cache) {
@@ -1914,4 +2108,32 @@ yb::Result<std::string> BlockBasedTable::GetMiddleKey() {
   return iter->key().ToBuffer();
 }
 
+yb::Result<std::vector<std::string>> BlockBasedTable::GetSplitKeys(size_t num_parts) {
+  auto index_reader = VERIFY_RESULT(GetIndexReader(ReadOptions::kDefault));
+
+  // TODO: remove this trick after https://github.com/yugabyte/yugabyte-db/issues/4720 is resolved.
+  auto se = yb::ScopeExit([this, &index_reader] {
+    index_reader.Release(rep_->table_options.block_cache.get());
+  });
+
+  const auto index_keys = VERIFY_RESULT(index_reader.value->GetSplitKeys(num_parts));
+  std::unique_ptr<InternalIterator> iter(
+      NewIterator(ReadOptions::kDefault, nullptr, /* skip_filters =*/ true));
+  std::vector<std::string> result;
+  result.reserve(index_keys.size());
+  for (const auto& index_key : index_keys) {
+    // Index keys could be shortened, so use the first actual key that is not less than index key.
+    iter->Seek(index_key);
+    if (!iter->Valid()) {
+      break;
+    }
+    auto user_key = ExtractUserKey(iter->key());
+    if (result.empty() || user_key.compare(result.back()) > 0) {
+      result.push_back(user_key.ToBuffer());
+    }
+  }
+  RETURN_NOT_OK(iter->status());
+  return result;
+}
+
 }  // namespace rocksdb
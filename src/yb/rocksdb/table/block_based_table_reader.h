@@ -189,6 +189,8 @@ class BlockBasedTable : public TableReader {
 
   yb::Result<std::string> GetMiddleKey() override;
 
+  yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) override;
+
   ~BlockBasedTable();
 
   bool TEST_filter_block_preloaded() const;
@@ -252,7 +254,7 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -267,7 +269,7 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker, const Slice& compression_dict);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
@@ -292,6 +294,9 @@ class BlockBasedTable : public TableReader {
 
   CHECKED_STATUS SetupFilter(InternalIterator* meta_iter);
 
+  // Reads dictionary that data blocks were compressed with, if any.
+  CHECKED_STATUS ReadCompressionDictBlock(InternalIterator* meta_iter);
+
   // Read the meta block from sst.
   static CHECKED_STATUS ReadMetaBlock(
       Rep* rep, std::unique_ptr<Block>* meta_block, std::unique_ptr<InternalIterator>* iter);
@@ -301,7 +306,13 @@ class BlockBasedTable : public TableReader {
       size_t* filter_size = nullptr);
 
   // CreateFilterIndexReader from sst
-  CHECKED_STATUS CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader);
+  CHECKED_STATUS CreateFilterIndexReader(std::unique_ptr<IndexReader>* filter_index_reader) const;
+
+  // Returns filter index reader, creating it on first access.
+  yb::Result<IndexReader*> GetFilterIndexReader() const;
+
+  // Returns query id that should be used to insert index and filter entries into block cache.
+  QueryId GetIndexAndFilterCacheQueryId(QueryId query_id) const;
 
   // Helper function to setup the cache key's prefix for block of file passed within a reader
   // instance. Used for both data and metadata files.
@@ -18,6 +18,8 @@
 // under the License.
 //
 #include <stdio.h>
+
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -135,6 +137,54 @@ TEST_F(BlockTest, SimpleTest) {
   delete iter;
 }
 
+// Checks seeks to existing and missing keys, that are mostly close to the current position.
+TEST_F(BlockTest, SeekNearby) {
+  Random rnd(301);
+  Options options = Options();
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  BlockBuilder builder(16);
+  const int kMaxKey = 10000;
+
+  // Only even keys are present in the block.
+  GenerateRandomKVs(&keys, &values, 0, kMaxKey, 2 /* step */);
+  for (size_t i = 0; i < keys.size(); i++) {
+    builder.Add(keys[i], values[i]);
+  }
+
+  BlockContents contents;
+  contents.data = builder.Finish();
+  contents.cachable = false;
+  Block reader(std::move(contents));
+
+  std::unique_ptr<InternalIterator> iter(reader.NewIterator(options.comparator));
+  int key = 0;
+  for (int i = 0; i < 100000; i++) {
+    // Mostly seek forward by a few keys, sometimes jump to a random key.
+    if (rnd.OneIn(10)) {
+      key = rnd.Uniform(kMaxKey + 10);
+    } else {
+      key += rnd.Uniform(40);
+      if (key > kMaxKey + 10) {
+        key = 0;
+      }
+    }
+    const auto target = GenerateKey(key, 0, 0, nullptr);
+    iter->Seek(target);
+
+    const auto it = std::lower_bound(keys.begin(), keys.end(), target);
+    if (it == keys.end()) {
+      ASSERT_FALSE(iter->Valid()) << "Target: " << target;
+    } else {
+      ASSERT_TRUE(iter->Valid()) << "Target: " << target;
+      ASSERT_EQ(*it, iter->key().ToString());
+      ASSERT_EQ(values[it - keys.begin()], iter->value().ToString());
+    }
+  }
+  ASSERT_OK(iter->status());
+}
+
 // return the block contents
 BlockContents GetBlockContents(std::unique_ptr<BlockBuilder> *builder,
                                const std::vector<std::string> &keys,
@@ -287,6 +337,33 @@ TEST_F(BlockTest, GetMiddleKey) {
   CheckMiddleKey(/* num_keys =*/ 16, block_restart_interval, /* expected_middle_key =*/ 8);
 }
 
+TEST_F(BlockTest, GetSplitKeys) {
+  BlockBuilder builder(/* block_restart_interval =*/ 2);
+  for (int i = 1; i <= 16; ++i) {
+    const auto padded_num = GetPaddedNum(i);
+    builder.Add("k" + padded_num, "v" + padded_num);
+  }
+
+  BlockContents contents;
+  contents.data = builder.Finish();
+  contents.cachable = false;
+  Block reader(std::move(contents));
+
+  // 8 restart points, with keys 1, 3, 5, ..., 15.
+  auto split_keys = ASSERT_RESULT(reader.GetSplitKeys(/* num_parts =*/ 4));
+  ASSERT_EQ(3, split_keys.size());
+  ASSERT_EQ("k" + GetPaddedNum(5), split_keys[0].ToString());
+  ASSERT_EQ("k" + GetPaddedNum(9), split_keys[1].ToString());
+  ASSERT_EQ("k" + GetPaddedNum(13), split_keys[2].ToString());
+
+  // Could not split into more parts than there are restart points.
+  split_keys = ASSERT_RESULT(reader.GetSplitKeys(/* num_parts =*/ 100));
+  ASSERT_EQ(7, split_keys.size());
+
+  split_keys = ASSERT_RESULT(reader.GetSplitKeys(/* num_parts =*/ 1));
+  ASSERT_TRUE(split_keys.empty());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char **argv) {
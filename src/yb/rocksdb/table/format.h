@@ -105,8 +105,12 @@ inline uint32_t GetCompressFormatForVersion(CompressionType compression_type,
   return version >= 2 ? 2 : 1;
 }
 
+// Footer version of files with data blocks compressed with a dictionary. Such blocks could not be
+// uncompressed by releases that do not read the compression dictionary, so they reject the file.
+constexpr uint32_t kCompressionDictFormatVersion = 3;
+
 inline bool BlockBasedTableSupportedVersion(uint32_t version) {
-  return version <= 2;
+  return version <= kCompressionDictFormatVersion;
 }
 
 // Footer encapsulates the fixed information stored at the tail
@@ -250,7 +254,8 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                const Slice& compression_dict = Slice());
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -259,10 +264,12 @@ extern Status ReadBlockContents(RandomAccessFileReader* file,
 // free this buffer.
 // For description of compress_format_version and possible values, see
 // util/compression.h
+// compression_dict is the dictionary the block was compressed with, empty if none was used.
 extern Status UncompressBlockContents(const char* data, size_t n,
                                       BlockContents* contents,
                                       uint32_t compress_format_version,
-                                      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+                                      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+                                      const Slice& compression_dict = Slice());
 
 // Implementation details follow.  Clients should ignore,
 
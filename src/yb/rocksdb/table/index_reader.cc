@@ -42,6 +42,10 @@ Result<Slice> BinarySearchIndexReader::GetMiddleKey() {
   return index_block_->GetMiddleKey();
 }
 
+Result<std::vector<Slice>> BinarySearchIndexReader::GetSplitKeys(size_t num_parts) {
+  return index_block_->GetSplitKeys(num_parts);
+}
+
 Status HashIndexReader::Create(const SliceTransform* hash_key_extractor,
                        const Footer& footer, RandomAccessFileReader* file,
                        Env* env, const ComparatorPtr& comparator,
@@ -131,6 +135,10 @@ Result<Slice> HashIndexReader::GetMiddleKey() {
   return index_block_->GetMiddleKey();
 }
 
+Result<std::vector<Slice>> HashIndexReader::GetSplitKeys(size_t num_parts) {
+  return index_block_->GetSplitKeys(num_parts);
+}
+
 class MultiLevelIterator : public InternalIterator {
  public:
   static constexpr auto kIterChainInitialCapacity = 4;
@@ -309,4 +317,8 @@ Result<Slice> MultiLevelIndexReader::GetMiddleKey() {
   return top_level_index_block_->GetMiddleKey();
 }
 
+Result<std::vector<Slice>> MultiLevelIndexReader::GetSplitKeys(size_t num_parts) {
+  return top_level_index_block_->GetSplitKeys(num_parts);
+}
+
 } // namespace rocksdb
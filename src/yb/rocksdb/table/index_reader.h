@@ -62,6 +62,10 @@ class IndexReader {
   // written into the index (see ShortenedIndexBuilder).
   virtual Result<Slice> GetMiddleKey() = 0;
 
+  // Returns up to num_parts - 1 keys from the index, which divide the indexed data into num_parts
+  // parts of roughly the same size. The same note as for GetMiddleKey applies.
+  virtual Result<std::vector<Slice>> GetSplitKeys(size_t num_parts) = 0;
+
   // The size of the index.
   virtual size_t size() const = 0;
   // Memory usage of the index block
@@ -114,6 +118,8 @@ class BinarySearchIndexReader : public IndexReader {
 
   Result<Slice> GetMiddleKey() override;
 
+  Result<std::vector<Slice>> GetSplitKeys(size_t num_parts) override;
+
  private:
   BinarySearchIndexReader(const ComparatorPtr& comparator,
                           std::unique_ptr<Block>&& index_block)
@@ -160,6 +166,8 @@ class HashIndexReader : public IndexReader {
 
   Result<Slice> GetMiddleKey() override;
 
+  Result<std::vector<Slice>> GetSplitKeys(size_t num_parts) override;
+
  private:
   HashIndexReader(const ComparatorPtr& comparator, std::unique_ptr<Block>&& index_block)
       : IndexReader(comparator), index_block_(std::move(index_block)) {
@@ -201,6 +209,8 @@ class MultiLevelIndexReader : public IndexReader {
 
   Result<Slice> GetMiddleKey() override;
 
+  Result<std::vector<Slice>> GetSplitKeys(size_t num_parts) override;
+
  private:
   size_t size() const override { return top_level_index_block_->size(); }
 
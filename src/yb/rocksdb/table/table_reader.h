@@ -120,6 +120,12 @@ class TableReader {
   virtual yb::Result<std::string> GetMiddleKey() {
     return STATUS(NotSupported, "GetMiddleKey() not supported");
   }
+
+  // Returns up to num_parts - 1 user keys in ascending order, which divide SST file into num_parts
+  // ranges of roughly the same size. Could be used to scan the file in parallel.
+  virtual yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) {
+    return STATUS(NotSupported, "GetSplitKeys() not supported");
+  }
 };
 
 }  // namespace rocksdb
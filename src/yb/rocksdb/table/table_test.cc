@@ -63,6 +63,8 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 #include "yb/util/enums.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/threadpool.h"
 
 DECLARE_double(cache_single_touch_ratio);
 
@@ -298,7 +300,7 @@ class TableConstructor: public Constructor {
                             internal_comparator,
                             int_tbl_prop_collector_factories,
                             options.compression,
-                            CompressionOptions(),
+                            options.compression_opts,
                             /* skip_filters */ false),
         TablePropertiesCollectorFactory::Context::kUnknownColumnFamily,
         file_writer_.get()));
@@ -1570,6 +1572,84 @@ TEST_F(BlockBasedTableTest, NumBlockStat) {
             c.GetTableReader()->GetTableProperties()->num_data_blocks);
 }
 
+TEST_F(BlockBasedTableTest, DataBlockPrefetch) {
+  constexpr size_t kNumBlocks = 20;
+  constexpr size_t kMaxPrefetchedBlocks = 8;
+  std::unique_ptr<yb::ThreadPool> pool;
+  ASSERT_OK(yb::ThreadPoolBuilder("prefetch").set_max_threads(1).Build(&pool));
+
+  Random rnd(test::RandomSeed());
+  TableConstructor c(BytewiseComparator());
+  Options options;
+  options.compression = kNoCompression;
+  options.statistics = CreateDBStatistics();
+  BlockBasedTableOptions table_options;
+  table_options.block_restart_interval = 1;
+  table_options.block_size = 1000;
+  table_options.block_cache = NewLRUCache(1024 * 1024);
+  table_options.data_block_prefetch_pool = pool.get();
+  table_options.max_prefetched_data_blocks = kMaxPrefetchedBlocks;
+  options.table_factory.reset(NewBlockBasedTableFactory(table_options));
+
+  for (size_t i = 0; i < kNumBlocks; ++i) {
+    // Each block holds a single key/value pair.
+    c.Add(RandomString(&rnd, 900), "val");
+  }
+
+  std::vector<std::string> ks;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &ks, &kvmap);
+
+  // Prefetch tasks that have not started before the iterator is destroyed are cancelled, and the
+  // iterator does not wait for them.
+  {
+    yb::CountDownLatch pool_blocked(1);
+    ASSERT_OK(pool->SubmitFunc([&pool_blocked] { pool_blocked.Wait(); }));
+    {
+      unique_ptr<InternalIterator> iter(c.NewIterator());
+      iter->SeekToFirst();
+      for (int i = 0; i != 2; ++i) {
+        ASSERT_TRUE(iter->Valid());
+        iter->Next();
+      }
+      ASSERT_TRUE(iter->Valid());
+    }
+    pool_blocked.CountDown();
+    pool->Wait();
+  }
+  ASSERT_EQ(3, options.statistics->getTickerCount(BLOCK_CACHE_DATA_MISS));
+
+  // Reading the third adjacent data block starts prefetch of the following ones.
+  {
+    unique_ptr<InternalIterator> iter(c.NewIterator());
+    iter->SeekToFirst();
+    for (int i = 0; i != 2; ++i) {
+      ASSERT_TRUE(iter->Valid());
+      iter->Next();
+    }
+    ASSERT_TRUE(iter->Valid());
+    pool->Wait();
+  }
+  // First three blocks were cached by the previous scan.
+  ASSERT_EQ(3 + kMaxPrefetchedBlocks,
+            options.statistics->getTickerCount(BLOCK_CACHE_DATA_MISS));
+  ASSERT_EQ(3, options.statistics->getTickerCount(BLOCK_CACHE_DATA_HIT));
+
+  // Prefetched blocks could be read without IO, but the following ones could not.
+  ReadOptions ro;
+  ro.read_tier = kBlockCacheTier;
+  unique_ptr<InternalIterator> iter(c.GetTableReader()->NewIterator(ro));
+  iter->SeekToFirst();
+  for (size_t i = 0; i != 3 + kMaxPrefetchedBlocks; ++i) {
+    ASSERT_TRUE(iter->Valid());
+    iter->Next();
+  }
+  ASSERT_FALSE(iter->Valid());
+  ASSERT_TRUE(iter->status().IsIncomplete());
+}
+
 // A simple tool that takes the snapshot of block cache statistics.
 class BlockCachePropertiesSnapshot {
  public:
@@ -1960,6 +2040,55 @@ TEST_F(BlockBasedTableTest, BlockReadCountTest) {
   }
 }
 
+TEST_F(BlockBasedTableTest, FixedSizeFilterOnDemand) {
+  Options options;
+  options.create_if_missing = true;
+  options.statistics = CreateDBStatistics();
+  auto mem_tracker = yb::MemTracker::CreateTracker("FixedSizeFilterOnDemand");
+  options.block_based_table_mem_tracker = mem_tracker;
+
+  BlockBasedTableOptions table_options;
+  table_options.block_cache = NewLRUCache(1024 * 1024);
+  table_options.cache_index_and_filter_blocks = true;
+  table_options.cache_index_and_filter_blocks_with_high_priority = true;
+  table_options.filter_policy.reset(NewFixedSizeFilterPolicy(
+      FilterPolicy::kDefaultFixedSizeFilterBits, FilterPolicy::kDefaultFixedSizeFilterErrorRate,
+      nullptr /* logger */));
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+
+  TableConstructor c(BytewiseComparator());
+  const std::string user_key = "k04";
+  const std::string encoded_key = InternalKey(user_key, 0, kTypeValue).Encode().ToString();
+  c.Add(encoded_key, "hello");
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options,
+           GetPlainInternalComparator(options.comparator), &keys, &kvmap);
+  auto reader = c.GetTableReader();
+
+  // Filter index is not loaded until the filter is used.
+  auto filter_mem_tracker = mem_tracker->FindChild(kFilterBlocksMemTrackerId);
+  ASSERT_NE(nullptr, filter_mem_tracker);
+  ASSERT_EQ(0, filter_mem_tracker->consumption());
+  ASSERT_EQ(0, reader->ApproximateMemoryUsage());
+
+  std::string value;
+  GetContext get_context(options.comparator, nullptr, nullptr, nullptr,
+                         GetContext::kNotFound, user_key, &value, nullptr,
+                         nullptr, nullptr);
+  ASSERT_OK(reader->Get(ReadOptions(), encoded_key, &get_context));
+  ASSERT_EQ(get_context.State(), GetContext::kFound);
+  ASSERT_EQ(value, "hello");
+
+  ASSERT_GT(reader->ApproximateMemoryUsage(), 0);
+  ASSERT_GT(filter_mem_tracker->consumption(), 0);
+  ASSERT_EQ(1, options.statistics->getTickerCount(BLOCK_CACHE_FILTER_MISS));
+  // Filter and index are inserted with high priority, while data block is not.
+  ASSERT_EQ(2, options.statistics->getTickerCount(BLOCK_CACHE_MULTI_TOUCH_ADD));
+  ASSERT_EQ(1, options.statistics->getTickerCount(BLOCK_CACHE_SINGLE_TOUCH_ADD));
+}
+
 TEST_F(BlockBasedTableTest, BlockCacheLeak) {
   // Check that when we reopen a table we don't lose access to blocks already
   // in the cache. This test checks whether the Table actually makes use of the
@@ -2169,6 +2298,73 @@ TEST_F(GeneralTableTest, ApproximateOffsetOfCompressed) {
   }
 }
 
+namespace {
+
+// Builds table with specified max_dict_bytes, checks that all entries are read back and returns
+// size of data blocks.
+uint64_t CheckCompressionDict(CompressionType type, uint32_t max_dict_bytes) {
+  // Values repeat across data blocks, but are not compressible inside a single value, so
+  // dictionary built from other data blocks improves compression.
+  Random rnd(301);
+  std::vector<std::string> values;
+  for (int i = 0; i < 5; ++i) {
+    values.push_back(RandomString(&rnd, 200));
+  }
+  TableConstructor c(BytewiseComparator());
+  for (int i = 0; i < 2000; ++i) {
+    c.Add("k" + std::to_string(100000 + i),
+          values[rnd.Uniform(static_cast<int>(values.size()))]);
+  }
+
+  Options options;
+  options.compression = type;
+  options.compression_opts.max_dict_bytes = max_dict_bytes;
+  BlockBasedTableOptions table_options;
+  table_options.block_size = 1024;
+  std::vector<std::string> keys;
+  stl_wrappers::KVMap kvmap;
+  const ImmutableCFOptions ioptions(options);
+  c.Finish(options, ioptions, table_options, GetPlainInternalComparator(options.comparator),
+           &keys, &kvmap);
+
+  std::unique_ptr<InternalIterator> iter(c.GetTableReader()->NewIterator(ReadOptions()));
+  auto expected = kvmap.begin();
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next(), ++expected) {
+    EXPECT_TRUE(expected != kvmap.end());
+    if (expected == kvmap.end()) {
+      break;
+    }
+    EXPECT_EQ(expected->first, iter->key().ToBuffer());
+    EXPECT_EQ(expected->second, iter->value().ToBuffer());
+  }
+  EXPECT_OK(iter->status());
+  EXPECT_TRUE(expected == kvmap.end());
+  return c.GetTableReader()->GetTableProperties()->data_size;
+}
+
+} // namespace
+
+TEST_F(GeneralTableTest, CompressionDict) {
+  std::vector<CompressionType> compression_types;
+  for (auto type : {kZlibCompression, kLZ4Compression, kLZ4HCCompression,
+                    kZSTDNotFinalCompression}) {
+    if (CompressionDictSupported(type)) {
+      compression_types.push_back(type);
+    } else {
+      fprintf(stderr, "skipping %s compression dictionary test\n",
+              CompressionTypeToString(type).c_str());
+    }
+  }
+
+  for (auto type : compression_types) {
+    SCOPED_TRACE(CompressionTypeToString(type));
+    const auto data_size_without_dict = CheckCompressionDict(type, 0);
+    // Dictionary is built from the first buffered data blocks, the rest are written right away.
+    const auto data_size_with_dict = CheckCompressionDict(type, 2048);
+    ASSERT_LT(data_size_with_dict, data_size_without_dict);
+  }
+}
+
 TEST_F(HarnessTest, Randomized) {
 #if defined(THREAD_SANITIZER)
   static constexpr int kMaxNumEntries = 200;
@@ -209,6 +209,7 @@ void TwoLevelIterator::InitDataBlock() {
       // second_level_iter is already constructed with this iterator, so
       // no need to change anything
     } else {
+      state_->OnNewSecondaryIterator(first_level_iter_.key(), handle);
       InternalIterator* iter = state_->NewSecondaryIterator(handle);
       data_block_handle_.assign(handle.cdata(), handle.size());
       SetSecondLevelIterator(iter);
@@ -40,6 +40,10 @@ struct TwoLevelIteratorState {
   virtual InternalIterator* NewSecondaryIterator(const Slice& handle) = 0;
   virtual bool PrefixMayMatch(const Slice& internal_key) = 0;
 
+  // Invoked before NewSecondaryIterator with the key and value of the first level entry.
+  // Could be used to detect sequential access and prefetch following secondary blocks.
+  virtual void OnNewSecondaryIterator(const Slice& index_key, const Slice& handle) {}
+
   // If call PrefixMayMatch()
   bool check_prefix_may_match;
 };
@@ -27,12 +27,15 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <thread>
 #include <gflags/gflags.h>
 #include "yb/rocksdb/util/coding.h"
 #include "yb/util/string_util.h"
 #include "yb/rocksdb/util/testharness.h"
 
 DECLARE_double(cache_single_touch_ratio);
+DECLARE_bool(clock_cache_frequency_admission);
+DECLARE_int32(clock_cache_frequency_sample_rate);
 
 namespace rocksdb {
 
@@ -741,6 +744,152 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+TEST_F(CacheTest, ClockCacheHitAndMiss) {
+  auto cache = NewClockCache(kCacheSize2, 0);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_OK(Insert(cache, 100, 101));
+  ASSERT_EQ(101, Lookup(cache, 100));
+  ASSERT_EQ(-1, Lookup(cache, 200));
+
+  ASSERT_OK(Insert(cache, 100, 102));
+  ASSERT_EQ(102, Lookup(cache, 100));
+  ASSERT_EQ(1U, cache->GetUsage());
+  ASSERT_EQ(1U, deleted_keys_.size());
+  ASSERT_EQ(101, deleted_values_[0]);
+
+  // Erased entry is deleted only after it is released.
+  Cache::Handle* handle = cache->Lookup(EncodeKey(100), kTestQueryId);
+  ASSERT_EQ(1U, cache->GetPinnedUsage());
+  Erase(cache, 100);
+  ASSERT_EQ(-1, Lookup(cache, 100));
+  ASSERT_EQ(0U, cache->GetUsage());
+  ASSERT_EQ(1U, deleted_keys_.size());
+  cache->Release(handle);
+  ASSERT_EQ(2U, deleted_keys_.size());
+  ASSERT_EQ(102, deleted_values_[1]);
+}
+
+TEST_F(CacheTest, ClockCacheEviction) {
+  auto cache = NewClockCache(kCacheSize2, 0);
+  for (int i = 0; i != kCacheSize2; ++i) {
+    ASSERT_OK(Insert(cache, i, i));
+  }
+  Cache::Handle* pinned = cache->Lookup(EncodeKey(0), kTestQueryId);
+  ASSERT_NE(nullptr, pinned);
+
+  for (int i = kCacheSize2; i != 3 * kCacheSize2; ++i) {
+    ASSERT_OK(Insert(cache, i, i));
+    ASSERT_EQ(static_cast<size_t>(kCacheSize2), cache->GetUsage());
+  }
+  ASSERT_EQ(static_cast<size_t>(2 * kCacheSize2), deleted_keys_.size());
+  // Pinned entry is not evicted.
+  ASSERT_EQ(0, Lookup(cache, 0));
+  cache->Release(pinned);
+
+  ASSERT_EQ(static_cast<size_t>(kCacheSize2 / 2), cache->Evict(kCacheSize2 / 2));
+  ASSERT_EQ(static_cast<size_t>(kCacheSize2 / 2), cache->GetUsage());
+}
+
+TEST_F(CacheTest, ClockCacheScanResistance) {
+  google::FlagSaver flag_saver;
+  // Record every lookup, so estimated frequencies are deterministic.
+  FLAGS_clock_cache_frequency_sample_rate = 1;
+  auto cache = NewClockCache(kCacheSize2, 0);
+  for (int i = 0; i != kCacheSize2; ++i) {
+    ASSERT_OK(Insert(cache, i, i));
+  }
+  for (int pass = 0; pass != 3; ++pass) {
+    for (int i = 0; i != kCacheSize2; ++i) {
+      ASSERT_EQ(i, Lookup(cache, i));
+    }
+  }
+
+  // Keys read once do not evict frequently accessed ones.
+  for (int i = 1000; i != 2000; ++i) {
+    ASSERT_EQ(-1, Lookup(cache, i));
+    ASSERT_OK(Insert(cache, i, i));
+  }
+  ASSERT_EQ(1000U, deleted_keys_.size());
+  for (int i = 0; i != kCacheSize2; ++i) {
+    ASSERT_EQ(i, Lookup(cache, i));
+  }
+
+  // Handle of the rejected entry could be used until released.
+  Cache::Handle* handle = nullptr;
+  ASSERT_OK(cache->Insert(EncodeKey(2000), kTestQueryId, EncodeValue(2000), 1,
+                          &CacheTest::Deleter, &handle));
+  ASSERT_NE(nullptr, handle);
+  ASSERT_EQ(2000, DecodeValue(cache->Value(handle)));
+  ASSERT_EQ(-1, Lookup(cache, 2000));
+  cache->Release(handle);
+  ASSERT_EQ(1001U, deleted_keys_.size());
+  ASSERT_EQ(2000, deleted_keys_.back());
+
+  // High priority entries are admitted regardless of access frequencies.
+  ASSERT_OK(Insert(cache, 2001, 2001, 1 /* charge */, kInMultiTouchId));
+  ASSERT_EQ(2001, Lookup(cache, 2001));
+  ASSERT_EQ(1002U, deleted_keys_.size());
+
+  // Without admission the scan flushes the cache.
+  FLAGS_clock_cache_frequency_admission = false;
+  for (int i = 3000; i != 3000 + kCacheSize2; ++i) {
+    ASSERT_OK(Insert(cache, i, i));
+  }
+  FLAGS_clock_cache_frequency_admission = true;
+  for (int i = 0; i != kCacheSize2; ++i) {
+    ASSERT_EQ(-1, Lookup(cache, i));
+  }
+}
+
+TEST_F(CacheTest, ClockCacheAdmitsEquallyUsedKeys) {
+  // Default sample rate, so only misses are recorded deterministically.
+  auto cache = NewClockCache(kCacheSize2, 0);
+  for (int i = 0; i != kCacheSize2; ++i) {
+    ASSERT_EQ(-1, Lookup(cache, i));
+    ASSERT_OK(Insert(cache, i, i));
+  }
+
+  // Keys that were missed as many times as cached ones replace them. Frequency estimation could
+  // overestimate some cached keys because of collisions, so a few keys could be rejected.
+  int admitted = 0;
+  for (int i = 1000; i != 1000 + kCacheSize2; ++i) {
+    ASSERT_EQ(-1, Lookup(cache, i));
+    ASSERT_OK(Insert(cache, i, i));
+    if (Lookup(cache, i) == i) {
+      ++admitted;
+    }
+  }
+  ASSERT_GE(admitted, kCacheSize2 * 95 / 100);
+}
+
+TEST_F(CacheTest, ClockCacheConcurrentAccess) {
+  constexpr int kNumThreads = 8;
+  constexpr int kNumKeys = 500;
+  constexpr int kOperationsPerThread = 20000;
+  auto cache = NewClockCache(kCacheSize2, kNumShardBits2);
+  std::vector<std::thread> threads;
+  for (int t = 0; t != kNumThreads; ++t) {
+    threads.emplace_back([cache, t] {
+      for (int i = 0; i != kOperationsPerThread; ++i) {
+        auto key = EncodeKey((i * 7 + t * 13) % kNumKeys);
+        Cache::Handle* handle = cache->Lookup(key, kTestQueryId);
+        if (handle == nullptr) {
+          ASSERT_OK(cache->Insert(key, kTestQueryId, EncodeValue(i), 1, &dumbDeleter, &handle));
+        }
+        cache->Release(handle);
+        if (i % 1000 == 0) {
+          cache->Erase(key);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  ASSERT_EQ(0U, cache->GetPinnedUsage());
+  ASSERT_LE(cache->GetUsage(), static_cast<size_t>(kCacheSize2));
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -0,0 +1,753 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+// Block cache that uses CLOCK replacement with TinyLFU admission.
+//
+// LRU cache has to move an entry inside its list on every hit, so lookups take the exclusive
+// shard mutex. Here a hit only increments the reference counter and sets the reference bit of
+// the entry, so lookups share the shard lock. Entries are evicted by the clock hand, that gives
+// a second chance to the entries referenced since its previous pass.
+//
+// New entry is admitted to the full cache only when its estimated access frequency is not lower
+// than the one of the eviction victim. So one time accessed blocks, for instance read by a long
+// scan, do not flush frequently accessed blocks out of the cache.
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+#include <gflags/gflags.h>
+
+#include "yb/rocksdb/cache.h"
+#include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/util/autovector.h"
+#include "yb/rocksdb/util/hash.h"
+#include "yb/rocksdb/util/statistics.h"
+
+#include "yb/util/locks.h"
+#include "yb/util/metrics.h"
+#include "yb/util/random_util.h"
+#include "yb/util/shared_lock.h"
+
+DEFINE_bool(clock_cache_frequency_admission, true,
+            "Whether clock cache should admit new entry only when it is estimated to be accessed "
+            "not less frequently than the entry it would evict.");
+
+DEFINE_int32(clock_cache_frequency_sample_rate, 8,
+             "Clock cache records one of this number of cache hits, chosen at random, in the "
+             "access frequency estimation of its shard, so concurrent cache hits rarely write to "
+             "the same memory. Misses are always recorded. 1 records every lookup.");
+
+namespace rocksdb {
+
+namespace {
+
+struct ClockHandle {
+  void* value;
+  void (*deleter)(const Slice&, void* value);
+  ClockHandle* next_hash;
+  // Neighbours in the circular list of the cached entries, that is traversed by the clock hand.
+  ClockHandle* next;
+  ClockHandle* prev;
+  size_t charge;
+  size_t key_length;
+  uint32_t hash;
+  // Number of references. While the entry is in cache, the cache holds one of them.
+  std::atomic<uint32_t> refs;
+  // Set on every hit and cleared by the clock hand.
+  std::atomic<bool> referenced;
+  char key_data[1];
+
+  Slice key() const {
+    return Slice(key_data, key_length);
+  }
+};
+
+ClockHandle* NewHandle(
+    const Slice& key, uint32_t hash, void* value, size_t charge,
+    void (*deleter)(const Slice& key, void* value), uint32_t refs) {
+  char* memory = new char[sizeof(ClockHandle) - 1 + key.size()];
+  auto* e = new (memory) ClockHandle();
+  e->value = value;
+  e->deleter = deleter;
+  e->next_hash = nullptr;
+  e->next = e->prev = nullptr;
+  e->charge = charge;
+  e->key_length = key.size();
+  e->hash = hash;
+  e->refs.store(refs, std::memory_order_relaxed);
+  e->referenced.store(false, std::memory_order_relaxed);
+  memcpy(e->key_data, key.data(), key.size());
+  return e;
+}
+
+void FreeHandle(ClockHandle* e) {
+  DCHECK_EQ(e->refs.load(std::memory_order_relaxed), 0);
+  (*e->deleter)(e->key(), e->value);
+  e->~ClockHandle();
+  delete[] reinterpret_cast<char*>(e);
+}
+
+// Chained hash table of the cached entries, the same as HandleTable of LRU cache.
+class ClockHandleTable {
+ public:
+  ClockHandleTable() {
+    Resize();
+  }
+
+  ~ClockHandleTable() {
+    delete[] list_;
+  }
+
+  ClockHandle* Lookup(const Slice& key, uint32_t hash) const {
+    return *FindPointer(key, hash);
+  }
+
+  // Inserts entry, returns replaced entry with the same key if any.
+  ClockHandle* Insert(ClockHandle* h) {
+    ClockHandle** ptr = FindPointer(h->key(), h->hash);
+    ClockHandle* old = *ptr;
+    h->next_hash = (old == nullptr ? nullptr : old->next_hash);
+    *ptr = h;
+    if (old == nullptr) {
+      ++elems_;
+      if (elems_ > length_) {
+        Resize();
+      }
+    }
+    return old;
+  }
+
+  ClockHandle* Remove(const Slice& key, uint32_t hash) {
+    ClockHandle** ptr = FindPointer(key, hash);
+    ClockHandle* result = *ptr;
+    if (result != nullptr) {
+      *ptr = result->next_hash;
+      --elems_;
+    }
+    return result;
+  }
+
+  size_t size() const {
+    return elems_;
+  }
+
+ private:
+  ClockHandle** FindPointer(const Slice& key, uint32_t hash) const {
+    ClockHandle** ptr = &list_[hash & (length_ - 1)];
+    while (*ptr != nullptr && ((*ptr)->hash != hash || key != (*ptr)->key())) {
+      ptr = &(*ptr)->next_hash;
+    }
+    return ptr;
+  }
+
+  void Resize() {
+    size_t new_length = 16;
+    while (new_length < elems_ * 1.5) {
+      new_length *= 2;
+    }
+    auto new_list = new ClockHandle*[new_length];
+    memset(new_list, 0, sizeof(new_list[0]) * new_length);
+    for (size_t i = 0; i < length_; i++) {
+      ClockHandle* h = list_[i];
+      while (h != nullptr) {
+        ClockHandle* next = h->next_hash;
+        ClockHandle** ptr = &new_list[h->hash & (new_length - 1)];
+        h->next_hash = *ptr;
+        *ptr = h;
+        h = next;
+      }
+    }
+    delete[] list_;
+    list_ = new_list;
+    length_ = new_length;
+  }
+
+  size_t length_ = 0;
+  size_t elems_ = 0;
+  ClockHandle** list_ = nullptr;
+};
+
+// Count-min sketch of the key access frequencies, used by TinyLFU admission.
+// Counters saturate at 15 and all of them are halved after the number of recorded accesses
+// reaches sample size, so estimation follows changes in the workload.
+class FrequencySketch {
+ public:
+  // Should be called under exclusive lock.
+  void Resize(size_t expected_entries) {
+    size_t width = kMinWidth;
+    while (width < expected_entries) {
+      width *= 2;
+    }
+    if (width == width_) {
+      return;
+    }
+    width_ = width;
+    shift_ = 32;
+    while (width > 1) {
+      width /= 2;
+      --shift_;
+    }
+    counters_.reset(new std::atomic<uint8_t>[kDepth * width_]);
+    for (size_t i = 0; i != kDepth * width_; ++i) {
+      counters_[i].store(0, std::memory_order_relaxed);
+    }
+    additions_.store(0, std::memory_order_relaxed);
+  }
+
+  // Could be called concurrently under shared lock. Concurrent increments of the same counter
+  // could be lost, that is fine for estimation.
+  void Increment(uint32_t hash) {
+    for (size_t row = 0; row != kDepth; ++row) {
+      auto& counter = counters_[Index(row, hash)];
+      auto value = counter.load(std::memory_order_relaxed);
+      if (value < kMaxCounter) {
+        counter.store(value + 1, std::memory_order_relaxed);
+      }
+    }
+    additions_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint8_t Estimate(uint32_t hash) const {
+    uint8_t result = kMaxCounter;
+    for (size_t row = 0; row != kDepth; ++row) {
+      result = std::min(result, counters_[Index(row, hash)].load(std::memory_order_relaxed));
+    }
+    return result;
+  }
+
+  // Should be called under exclusive lock.
+  void MaybeAge() {
+    if (additions_.load(std::memory_order_relaxed) < kSampleSizeMultiplier * width_) {
+      return;
+    }
+    for (size_t i = 0; i != kDepth * width_; ++i) {
+      counters_[i].store(counters_[i].load(std::memory_order_relaxed) / 2,
+                         std::memory_order_relaxed);
+    }
+    additions_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr size_t kDepth = 4;
+  static constexpr size_t kMinWidth = 1024;
+  static constexpr size_t kSampleSizeMultiplier = 10;
+  static constexpr uint8_t kMaxCounter = 15;
+
+  size_t Index(size_t row, uint32_t hash) const {
+    static constexpr uint32_t kSeeds[kDepth] = {0x97cb3127, 0xb4b82e39, 0x9e3779b1, 0x85ebca6b};
+    // Upper bits of the hash are used to select shard, so they are mixed into the lower ones.
+    uint32_t mixed = (hash ^ (hash >> 16)) * kSeeds[row];
+    return row * width_ + (mixed >> shift_);
+  }
+
+  size_t width_ = 0;
+  int shift_ = 32;
+  std::unique_ptr<std::atomic<uint8_t>[]> counters_;
+  std::atomic<size_t> additions_{0};
+};
+
+// Expected average charge of the cache entry, used to size the frequency sketch.
+constexpr size_t kExpectedEntryCharge = 16 * 1024;
+
+class ClockCacheShard {
+ public:
+  ClockCacheShard() {
+    sketch_.Resize(0);
+  }
+
+  ~ClockCacheShard() {
+    ClockHandle* e = hand_;
+    for (size_t i = table_.size(); i != 0; --i) {
+      ClockHandle* next = e->next;
+      // Entries should not be referenced outside of the cache at this point.
+      if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        FreeHandle(e);
+      }
+      e = next;
+    }
+  }
+
+  void SetCapacity(size_t capacity) {
+    autovector<ClockHandle*> evicted;
+    {
+      std::lock_guard<yb::rw_spinlock> lock(mutex_);
+      capacity_ = capacity;
+      sketch_.Resize(capacity / kExpectedEntryCharge);
+      EvictUntilFits(0, &evicted);
+    }
+    FreeAll(evicted);
+  }
+
+  void SetStrictCapacityLimit(bool strict_capacity_limit) {
+    std::lock_guard<yb::rw_spinlock> lock(mutex_);
+    strict_capacity_limit_ = strict_capacity_limit;
+  }
+
+  void SetMetrics(std::shared_ptr<yb::CacheMetrics> metrics) {
+    metrics_ = std::move(metrics);
+  }
+
+  // High priority entries are admitted without comparing access frequencies.
+  Status Insert(const Slice& key, uint32_t hash, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value), Cache::Handle** handle,
+                bool high_priority, Statistics* statistics);
+
+  Cache::Handle* Lookup(const Slice& key, uint32_t hash, Statistics* statistics);
+
+  void Release(Cache::Handle* handle) {
+    auto* e = reinterpret_cast<ClockHandle*>(handle);
+    // Last reference could be held only outside of the cache, so the entry is already removed.
+    if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      FreeHandle(e);
+    }
+  }
+
+  void Erase(const Slice& key, uint32_t hash) {
+    autovector<ClockHandle*> removed;
+    {
+      std::lock_guard<yb::rw_spinlock> lock(mutex_);
+      ClockHandle* e = table_.Remove(key, hash);
+      if (e != nullptr) {
+        RemoveFromCache(e, &removed);
+      }
+    }
+    FreeAll(removed);
+  }
+
+  size_t Evict(size_t required) {
+    autovector<ClockHandle*> evicted;
+    size_t result = 0;
+    {
+      std::lock_guard<yb::rw_spinlock> lock(mutex_);
+      while (result < required) {
+        ClockHandle* victim = FindVictim();
+        if (victim == nullptr) {
+          break;
+        }
+        result += victim->charge;
+        table_.Remove(victim->key(), victim->hash);
+        RemoveFromCache(victim, &evicted);
+      }
+    }
+    FreeAll(evicted);
+    return result;
+  }
+
+  size_t GetUsage() const {
+    return usage_.load(std::memory_order_relaxed);
+  }
+
+  size_t GetPinnedUsage() const {
+    yb::SharedLock<yb::rw_spinlock> lock(mutex_);
+    size_t result = 0;
+    ClockHandle* e = hand_;
+    for (size_t i = table_.size(); i != 0; --i, e = e->next) {
+      if (e->refs.load(std::memory_order_relaxed) > 1) {
+        result += e->charge;
+      }
+    }
+    return result;
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) {
+    if (thread_safe) {
+      mutex_.lock_shared();
+    }
+    ClockHandle* e = hand_;
+    for (size_t i = table_.size(); i != 0; --i, e = e->next) {
+      callback(e->value, e->charge);
+    }
+    if (thread_safe) {
+      mutex_.unlock_shared();
+    }
+  }
+
+  std::pair<size_t, size_t> TEST_GetIndividualUsages() const {
+    // Clock cache does not distinguish single and multi touch entries.
+    return {0, GetUsage()};
+  }
+
+ private:
+  // Moves the clock hand until it finds an entry that could be evicted, i.e. not referenced
+  // outside of the cache and not accessed since the previous pass of the hand.
+  // Returns nullptr when all entries are pinned. Requires exclusive lock.
+  ClockHandle* FindVictim() {
+    // The first pass clears the reference bits, so an unpinned entry is found during the second.
+    for (size_t i = 2 * table_.size(); i != 0; --i) {
+      ClockHandle* e = hand_;
+      hand_ = e->next;
+      if (e->refs.load(std::memory_order_acquire) > 1) {
+        continue;
+      }
+      if (e->referenced.exchange(false, std::memory_order_relaxed)) {
+        continue;
+      }
+      return e;
+    }
+    return nullptr;
+  }
+
+  // Decides whether a new entry should be admitted, before anything is evicted for it. When the
+  // entry does not fit, it is admitted only when it is estimated to be accessed not less frequently
+  // than the first entry that would be evicted. Requires exclusive lock.
+  bool ShouldAdmit(uint32_t hash, size_t charge) {
+    if (!FLAGS_clock_cache_frequency_admission ||
+        usage_.load(std::memory_order_relaxed) + charge <= capacity_) {
+      return true;
+    }
+    ClockHandle* victim = FindVictim();
+    if (victim == nullptr) {
+      return true;
+    }
+    // Return the hand to the victim, so it is the first entry evicted by EvictUntilFits.
+    hand_ = victim;
+    return sketch_.Estimate(hash) >= sketch_.Estimate(victim->hash);
+  }
+
+  // Evicts entries until an entry with the specified charge fits into capacity, or all remaining
+  // entries are pinned. Requires exclusive lock.
+  void EvictUntilFits(size_t charge, autovector<ClockHandle*>* evicted) {
+    while (usage_.load(std::memory_order_relaxed) + charge > capacity_) {
+      ClockHandle* victim = FindVictim();
+      if (victim == nullptr) {
+        return;
+      }
+      table_.Remove(victim->key(), victim->hash);
+      RemoveFromCache(victim, evicted);
+    }
+  }
+
+  // Adds entry to the clock list right behind the hand, so it is visited last. Requires exclusive
+  // lock.
+  void ListInsert(ClockHandle* e) {
+    if (hand_ == nullptr) {
+      e->next = e->prev = e;
+      hand_ = e;
+      return;
+    }
+    e->next = hand_;
+    e->prev = hand_->prev;
+    e->prev->next = e;
+    hand_->prev = e;
+  }
+
+  // Removes entry, that was already removed from the table, from the clock list and drops the
+  // cache reference. Entry is added to the removed list when it is not referenced anymore.
+  // Requires exclusive lock.
+  void RemoveFromCache(ClockHandle* e, autovector<ClockHandle*>* removed) {
+    if (e->next == e) {
+      hand_ = nullptr;
+    } else {
+      if (hand_ == e) {
+        hand_ = e->next;
+      }
+      e->prev->next = e->next;
+      e->next->prev = e->prev;
+    }
+    e->next = e->prev = nullptr;
+    usage_.fetch_sub(e->charge, std::memory_order_relaxed);
+    if (metrics_) {
+      metrics_->cache_usage->DecrementBy(e->charge);
+      metrics_->multi_touch_cache_usage->DecrementBy(e->charge);
+    }
+    if (e->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      removed->push_back(e);
+    }
+  }
+
+  static void FreeAll(const autovector<ClockHandle*>& entries) {
+    for (auto* e : entries) {
+      FreeHandle(e);
+    }
+  }
+
+  mutable yb::rw_spinlock mutex_;
+  size_t capacity_ = 0;
+  bool strict_capacity_limit_ = false;
+  // Modified under exclusive lock, but read without lock.
+  std::atomic<size_t> usage_{0};
+  ClockHandleTable table_;
+  // Next entry to be checked by the clock hand, nullptr when the cache is empty.
+  ClockHandle* hand_ = nullptr;
+  FrequencySketch sketch_;
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+Cache::Handle* ClockCacheShard::Lookup(
+    const Slice& key, uint32_t hash, Statistics* statistics) {
+  ClockHandle* e;
+  {
+    yb::SharedLock<yb::rw_spinlock> lock(mutex_);
+    e = table_.Lookup(key, hash);
+    if (e != nullptr) {
+      e->refs.fetch_add(1, std::memory_order_relaxed);
+      // Avoid writing to the shared cache line when the bit is already set.
+      if (!e->referenced.load(std::memory_order_relaxed)) {
+        e->referenced.store(true, std::memory_order_relaxed);
+      }
+    }
+    // Sampled hits keep the relative frequencies of cached keys. Each miss is recorded, since
+    // it is followed by insert, whose admission compares the missed key with a cached one.
+    if (e == nullptr || FLAGS_clock_cache_frequency_sample_rate <= 1 ||
+        yb::RandomWithChance(FLAGS_clock_cache_frequency_sample_rate)) {
+      sketch_.Increment(hash);
+    }
+  }
+
+  if (statistics != nullptr) {
+    if (e != nullptr) {
+      RecordTick(statistics, BLOCK_CACHE_HIT);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_READ, e->charge);
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_MISS);
+    }
+  }
+
+  if (metrics_ != nullptr) {
+    metrics_->lookups->Increment();
+    if (e != nullptr) {
+      metrics_->cache_hits->Increment();
+    } else {
+      metrics_->cache_misses->Increment();
+    }
+  }
+  return reinterpret_cast<Cache::Handle*>(e);
+}
+
+Status ClockCacheShard::Insert(
+    const Slice& key, uint32_t hash, void* value, size_t charge,
+    void (*deleter)(const Slice& key, void* value), Cache::Handle** handle,
+    bool high_priority, Statistics* statistics) {
+  // One reference for the cache and one for the returned handle.
+  ClockHandle* e = NewHandle(key, hash, value, charge, deleter, handle == nullptr ? 1 : 2);
+  autovector<ClockHandle*> removed;
+  Status s;
+  bool inserted = false;
+  {
+    std::lock_guard<yb::rw_spinlock> lock(mutex_);
+    sketch_.MaybeAge();
+    bool admitted = high_priority || ShouldAdmit(hash, charge);
+    if (admitted) {
+      EvictUntilFits(charge, &removed);
+    }
+    if (admitted && strict_capacity_limit_ &&
+        usage_.load(std::memory_order_relaxed) + charge > capacity_) {
+      // Same as LRU cache, the caller keeps ownership of the value.
+      e->~ClockHandle();
+      delete[] reinterpret_cast<char*>(e);
+      e = nullptr;
+      if (handle != nullptr) {
+        *handle = nullptr;
+      }
+      s = STATUS(Incomplete, "Insert failed due to cache being full.");
+    } else if (!admitted) {
+      // Value is not cached, but returned handle could still be used by the caller. Value is
+      // deleted when the handle is released.
+      e->refs.fetch_sub(1, std::memory_order_relaxed);
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      } else {
+        removed.push_back(e);
+      }
+    } else {
+      ClockHandle* old = table_.Insert(e);
+      ListInsert(e);
+      usage_.fetch_add(charge, std::memory_order_relaxed);
+      if (metrics_) {
+        metrics_->cache_usage->IncrementBy(charge);
+        metrics_->multi_touch_cache_usage->IncrementBy(charge);
+      }
+      if (old != nullptr) {
+        RemoveFromCache(old, &removed);
+      }
+      if (handle != nullptr) {
+        *handle = reinterpret_cast<Cache::Handle*>(e);
+      }
+      inserted = true;
+    }
+  }
+  FreeAll(removed);
+
+  if (statistics != nullptr) {
+    if (inserted) {
+      RecordTick(statistics, BLOCK_CACHE_ADD);
+      RecordTick(statistics, BLOCK_CACHE_BYTES_WRITE, charge);
+    } else {
+      RecordTick(statistics, BLOCK_CACHE_ADD_FAILURES);
+    }
+  }
+  return s;
+}
+
+class ShardedClockCache : public Cache {
+ public:
+  ShardedClockCache(size_t capacity, int num_shard_bits, bool strict_capacity_limit)
+      : num_shard_bits_(num_shard_bits),
+        shards_(new ClockCacheShard[1 << num_shard_bits]),
+        capacity_(capacity),
+        strict_capacity_limit_(strict_capacity_limit) {
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetStrictCapacityLimit(strict_capacity_limit);
+    }
+    SetCapacity(capacity);
+  }
+
+  void SetCapacity(size_t capacity) override {
+    const size_t per_shard = (capacity + (num_shards() - 1)) / num_shards();
+    std::lock_guard<std::mutex> lock(capacity_mutex_);
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetCapacity(per_shard);
+    }
+    capacity_ = capacity;
+  }
+
+  Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
+                void (*deleter)(const Slice& key, void* value),
+                Handle** handle, Statistics* statistics) override {
+    // Queries with no cache query ids are not cached.
+    if (query_id == kNoCacheQueryId) {
+      return Status::OK();
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Insert(
+        key, hash, value, charge, deleter, handle, query_id == kInMultiTouchId, statistics);
+  }
+
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+    if (query_id == kNoCacheQueryId) {
+      return nullptr;
+    }
+    const uint32_t hash = HashSlice(key);
+    return shards_[Shard(hash)].Lookup(key, hash, statistics);
+  }
+
+  void Release(Handle* handle) override {
+    auto* h = reinterpret_cast<ClockHandle*>(handle);
+    shards_[Shard(h->hash)].Release(handle);
+  }
+
+  void Erase(const Slice& key) override {
+    const uint32_t hash = HashSlice(key);
+    shards_[Shard(hash)].Erase(key, hash);
+  }
+
+  void* Value(Handle* handle) override {
+    return reinterpret_cast<ClockHandle*>(handle)->value;
+  }
+
+  uint64_t NewId() override {
+    return last_id_.fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  size_t GetCapacity() const override {
+    return capacity_;
+  }
+
+  bool HasStrictCapacityLimit() const override {
+    return strict_capacity_limit_;
+  }
+
+  size_t GetUsage() const override {
+    size_t usage = 0;
+    for (int s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetUsage();
+    }
+    return usage;
+  }
+
+  size_t GetUsage(Handle* handle) const override {
+    return reinterpret_cast<ClockHandle*>(handle)->charge;
+  }
+
+  size_t GetPinnedUsage() const override {
+    size_t usage = 0;
+    for (int s = 0; s != num_shards(); ++s) {
+      usage += shards_[s].GetPinnedUsage();
+    }
+    return usage;
+  }
+
+  void DisownData() override {
+    shards_.release();
+  }
+
+  void ApplyToAllCacheEntries(void (*callback)(void*, size_t), bool thread_safe) override {
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].ApplyToAllCacheEntries(callback, thread_safe);
+    }
+  }
+
+  void SetMetrics(const scoped_refptr<yb::MetricEntity>& entity) override {
+    metrics_ = std::make_shared<yb::CacheMetrics>(entity);
+    for (int s = 0; s != num_shards(); ++s) {
+      shards_[s].SetMetrics(metrics_);
+    }
+  }
+
+  size_t Evict(size_t bytes_to_evict) override {
+    size_t total_evicted = 0;
+    // Start at random shard.
+    auto index = Shard(yb::RandomUniformInt<uint32_t>());
+    for (int i = 0; bytes_to_evict > total_evicted && i != num_shards(); ++i) {
+      total_evicted += shards_[index].Evict(bytes_to_evict - total_evicted);
+      index = (index + 1) & (num_shards() - 1);
+    }
+    return total_evicted;
+  }
+
+  std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() override {
+    std::vector<std::pair<size_t, size_t>> cache_sizes;
+    cache_sizes.reserve(num_shards());
+    for (int s = 0; s != num_shards(); ++s) {
+      cache_sizes.emplace_back(shards_[s].TEST_GetIndividualUsages());
+    }
+    return cache_sizes;
+  }
+
+ private:
+  static uint32_t HashSlice(const Slice& s) {
+    return Hash(s.data(), s.size(), 0);
+  }
+
+  uint32_t Shard(uint32_t hash) const {
+    // Note, hash >> 32 yields hash in gcc, not the zero we expect!
+    return (num_shard_bits_ > 0) ? (hash >> (32 - num_shard_bits_)) : 0;
+  }
+
+  int num_shards() const {
+    return 1 << num_shard_bits_;
+  }
+
+  const int num_shard_bits_;
+  std::unique_ptr<ClockCacheShard[]> shards_;
+  std::mutex capacity_mutex_;
+  size_t capacity_;
+  const bool strict_capacity_limit_;
+  std::atomic<uint64_t> last_id_{0};
+  std::shared_ptr<yb::CacheMetrics> metrics_;
+};
+
+}  // namespace
+
+shared_ptr<Cache> NewClockCache(size_t capacity, int num_shard_bits,
+                                bool strict_capacity_limit) {
+  if (num_shard_bits >= 20) {
+    return nullptr;  // the cache cannot be sharded into too many fine pieces
+  }
+  return std::make_shared<ShardedClockCache>(capacity, num_shard_bits, strict_capacity_limit);
+}
+
+}  // namespace rocksdb
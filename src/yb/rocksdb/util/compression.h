@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <limits>
 #include <string>
+#include <vector>
 
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/util/coding.h"
@@ -49,6 +50,9 @@
 
 #if defined(ZSTD)
 #include <zstd.h>
+#if ZSTD_VERSION_NUMBER >= 10103  // v1.1.3+
+#include <zdict.h>
+#endif
 #endif
 
 namespace rocksdb {
@@ -132,6 +136,30 @@ inline std::string CompressionTypeToString(CompressionType compression_type) {
   }
 }
 
+// Returns whether blocks compressed with compression_type could use a compression dictionary, see
+// CompressionOptions::max_dict_bytes.
+inline bool CompressionDictSupported(CompressionType compression_type) {
+  switch (compression_type) {
+    case kZlibCompression:
+      return Zlib_Supported();
+    case kLZ4Compression:
+    case kLZ4HCCompression:
+#if defined(LZ4) && LZ4_VERSION_NUMBER >= 10400  // r124+
+      return true;
+#else
+      return false;
+#endif
+    case kZSTDNotFinalCompression:
+#if defined(ZSTD) && ZSTD_VERSION_NUMBER >= 500  // v0.5.0+
+      return true;
+#else
+      return false;
+#endif
+    default:
+      return false;
+  }
+}
+
 // compress_format_version can have two values:
 // 1 -- decompressed sizes for BZip2 and Zlib are not included in the compressed
 // block. Also, decompressed sizes for LZ4 are encoded in platform-dependent
@@ -198,7 +226,8 @@ inline bool GetDecompressedSizeInfo(const char** input_data,
 inline bool Zlib_Compress(const CompressionOptions& opts,
                           uint32_t compress_format_version,
                           const char* input, size_t length,
-                          ::std::string* output) {
+                          ::std::string* output,
+                          const Slice& compression_dict = Slice()) {
 #ifdef ZLIB
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -228,6 +257,17 @@ inline bool Zlib_Compress(const CompressionOptions& opts,
     return false;
   }
 
+  if (compression_dict.size()) {
+    // Initialize the compression library's dictionary
+    st = deflateSetDictionary(
+        &_stream, reinterpret_cast<const Bytef*>(compression_dict.data()),
+        static_cast<unsigned int>(compression_dict.size()));
+    if (st != Z_OK) {
+      deflateEnd(&_stream);
+      return false;
+    }
+  }
+
   // Compress the input, and put compressed data in output.
   _stream.next_in = (Bytef *)input;
   _stream.avail_in = static_cast<unsigned int>(length);
@@ -268,6 +308,7 @@ inline bool Zlib_Compress(const CompressionOptions& opts,
 inline char* Zlib_Uncompress(const char* input_data, size_t input_length,
                              int* decompress_size,
                              uint32_t compress_format_version,
+                             const Slice& compression_dict = Slice(),
                              int windowBits = -14) {
 #ifdef ZLIB
   uint32_t output_len = 0;
@@ -297,6 +338,17 @@ inline char* Zlib_Uncompress(const char* input_data, size_t input_length,
     return nullptr;
   }
 
+  if (compression_dict.size()) {
+    // Initialize the compression library's dictionary. Raw inflate accepts it right after init.
+    st = inflateSetDictionary(
+        &_stream, reinterpret_cast<const Bytef*>(compression_dict.data()),
+        static_cast<unsigned int>(compression_dict.size()));
+    if (st != Z_OK) {
+      inflateEnd(&_stream);
+      return nullptr;
+    }
+  }
+
   _stream.next_in = (Bytef *)input_data;
   _stream.avail_in = static_cast<unsigned int>(input_length);
 
@@ -498,7 +550,8 @@ inline char* BZip2_Uncompress(const char* input_data, size_t input_length,
 // header in varint32 format
 inline bool LZ4_Compress(const CompressionOptions& opts,
                          uint32_t compress_format_version, const char* input,
-                         size_t length, ::std::string* output) {
+                         size_t length, ::std::string* output,
+                         const Slice& compression_dict = Slice()) {
 #ifdef LZ4
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -521,9 +574,27 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 
   int compressBound = LZ4_compressBound(static_cast<int>(length));
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  int outlen =
-      LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
-                                 static_cast<int>(length), compressBound);
+  int outlen;
+#if LZ4_VERSION_NUMBER >= 10400  // r124+
+  if (compression_dict.size()) {
+    LZ4_stream_t* stream = LZ4_createStream();
+    LZ4_loadDict(stream, compression_dict.cdata(), static_cast<int>(compression_dict.size()));
+    outlen = LZ4_compress_fast_continue(
+        stream, input, &(*output)[output_header_len], static_cast<int>(length), compressBound,
+        1 /* acceleration */);
+    LZ4_freeStream(stream);
+  } else {
+    outlen = LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
+                                        static_cast<int>(length), compressBound);
+  }
+#else
+  if (compression_dict.size()) {
+    // Dictionary is not supported by this LZ4 version.
+    return false;
+  }
+  outlen = LZ4_compress_limitedOutput(input, &(*output)[output_header_len],
+                                      static_cast<int>(length), compressBound);
+#endif
   if (outlen == 0) {
     return false;
   }
@@ -539,7 +610,8 @@ inline bool LZ4_Compress(const CompressionOptions& opts,
 // header in varint32 format
 inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
                             int* decompress_size,
-                            uint32_t compress_format_version) {
+                            uint32_t compress_format_version,
+                            const Slice& compression_dict = Slice()) {
 #ifdef LZ4
   uint32_t output_len = 0;
   if (compress_format_version == 2) {
@@ -559,9 +631,25 @@ inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
     input_data += 8;
   }
   char* output = new char[output_len];
+#if LZ4_VERSION_NUMBER >= 10400  // r124+
+  if (compression_dict.size()) {
+    *decompress_size = LZ4_decompress_safe_usingDict(
+        input_data, output, static_cast<int>(input_length), static_cast<int>(output_len),
+        compression_dict.cdata(), static_cast<int>(compression_dict.size()));
+  } else {
+    *decompress_size =
+        LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
+                            static_cast<int>(output_len));
+  }
+#else
+  if (compression_dict.size()) {
+    delete[] output;
+    return nullptr;
+  }
   *decompress_size =
       LZ4_decompress_safe(input_data, output, static_cast<int>(input_length),
                           static_cast<int>(output_len));
+#endif
   if (*decompress_size < 0) {
     delete[] output;
     return nullptr;
@@ -578,7 +666,8 @@ inline char* LZ4_Uncompress(const char* input_data, size_t input_length,
 // header in varint32 format
 inline bool LZ4HC_Compress(const CompressionOptions& opts,
                            uint32_t compress_format_version, const char* input,
-                           size_t length, ::std::string* output) {
+                           size_t length, ::std::string* output,
+                           const Slice& compression_dict = Slice()) {
 #ifdef LZ4
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -602,11 +691,30 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
   int compressBound = LZ4_compressBound(static_cast<int>(length));
   output->resize(static_cast<size_t>(output_header_len + compressBound));
   int outlen;
-#ifdef LZ4_VERSION_MAJOR  // they only started defining this since r113
+#if LZ4_VERSION_NUMBER >= 10400  // r124+
+  if (compression_dict.size()) {
+    LZ4_streamHC_t* stream = LZ4_createStreamHC();
+    LZ4_resetStreamHC(stream, opts.level);
+    LZ4_loadDictHC(stream, compression_dict.cdata(), static_cast<int>(compression_dict.size()));
+    outlen = LZ4_compress_HC_continue(
+        stream, input, &(*output)[output_header_len], static_cast<int>(length), compressBound);
+    LZ4_freeStreamHC(stream);
+  } else {
+    outlen = LZ4_compressHC2_limitedOutput(input, &(*output)[output_header_len],
+                                           static_cast<int>(length), compressBound, opts.level);
+  }
+#elif defined(LZ4_VERSION_MAJOR)  // they only started defining this since r113
+  if (compression_dict.size()) {
+    // Dictionary is not supported by this LZ4 version.
+    return false;
+  }
   outlen = LZ4_compressHC2_limitedOutput(input, &(*output)[output_header_len],
                                          static_cast<int>(length),
                                          compressBound, opts.level);
 #else
+  if (compression_dict.size()) {
+    return false;
+  }
   outlen =
       LZ4_compressHC_limitedOutput(input, &(*output)[output_header_len],
                                    static_cast<int>(length), compressBound);
@@ -621,7 +729,8 @@ inline bool LZ4HC_Compress(const CompressionOptions& opts,
 }
 
 inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
-                          size_t length, ::std::string* output) {
+                          size_t length, ::std::string* output,
+                          const Slice& compression_dict = Slice()) {
 #ifdef ZSTD
   if (length > std::numeric_limits<uint32_t>::max()) {
     // Can't compress more than 4GB
@@ -633,9 +742,26 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 
   size_t compressBound = ZSTD_compressBound(length);
   output->resize(static_cast<size_t>(output_header_len + compressBound));
-  size_t outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
-                                input, length, opts.level);
-  if (outlen == 0) {
+  size_t outlen;
+#if ZSTD_VERSION_NUMBER >= 500  // v0.5.0+
+  if (compression_dict.size()) {
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    outlen = ZSTD_compress_usingDict(
+        context, &(*output)[output_header_len], compressBound, input, length,
+        compression_dict.data(), compression_dict.size(), opts.level);
+    ZSTD_freeCCtx(context);
+  } else {
+    outlen = ZSTD_compress(&(*output)[output_header_len], compressBound, input, length,
+                           opts.level);
+  }
+#else
+  if (compression_dict.size()) {
+    return false;
+  }
+  outlen = ZSTD_compress(&(*output)[output_header_len], compressBound,
+                         input, length, opts.level);
+#endif
+  if (outlen == 0 || ZSTD_isError(outlen)) {
     return false;
   }
   output->resize(output_header_len + outlen);
@@ -645,7 +771,8 @@ inline bool ZSTD_Compress(const CompressionOptions& opts, const char* input,
 }
 
 inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
-                             int* decompress_size) {
+                             int* decompress_size,
+                             const Slice& compression_dict = Slice()) {
 #ifdef ZSTD
   uint32_t output_len = 0;
   if (!compression::GetDecompressedSizeInfo(&input_data, &input_length,
@@ -654,8 +781,24 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   }
 
   char* output = new char[output_len];
-  size_t actual_output_length =
-      ZSTD_decompress(output, output_len, input_data, input_length);
+  size_t actual_output_length;
+#if ZSTD_VERSION_NUMBER >= 500  // v0.5.0+
+  if (compression_dict.size()) {
+    ZSTD_DCtx* context = ZSTD_createDCtx();
+    actual_output_length = ZSTD_decompress_usingDict(
+        context, output, output_len, input_data, input_length, compression_dict.data(),
+        compression_dict.size());
+    ZSTD_freeDCtx(context);
+  } else {
+    actual_output_length = ZSTD_decompress(output, output_len, input_data, input_length);
+  }
+#else
+  actual_output_length = ZSTD_decompress(output, output_len, input_data, input_length);
+#endif
+  if (ZSTD_isError(actual_output_length)) {
+    delete[] output;
+    return nullptr;
+  }
   assert(actual_output_length == output_len);
   *decompress_size = static_cast<int>(actual_output_length);
   return output;
@@ -663,4 +806,25 @@ inline char* ZSTD_Uncompress(const char* input_data, size_t input_length,
   return nullptr;
 }
 
+// Trains ZSTD dictionary of at most max_dict_bytes from samples, that are concatenated in
+// samples_buffer. Returns empty string if training is not supported or failed, in this case caller
+// could fall back to raw content dictionary.
+inline std::string ZSTD_TrainDictionary(const std::string& samples_buffer,
+                                        const std::vector<size_t>& sample_lens,
+                                        size_t max_dict_bytes) {
+#if defined(ZSTD) && ZSTD_VERSION_NUMBER >= 10103  // v1.1.3+
+  std::string dict_data(max_dict_bytes, '\0');
+  size_t dict_len = ZDICT_trainFromBuffer(
+      &dict_data[0], max_dict_bytes, samples_buffer.data(), sample_lens.data(),
+      static_cast<unsigned>(sample_lens.size()));
+  if (ZDICT_isError(dict_len)) {
+    return std::string();
+  }
+  dict_data.resize(dict_len);
+  return dict_data;
+#else
+  return std::string();
+#endif
+}
+
 }  // namespace rocksdb
@@ -137,6 +137,16 @@ void SetFD_CLOEXEC(int fd, const EnvOptions* options) {
   }
 }
 
+#if defined(__linux__)
+constexpr int kDirectReadFlags = O_DIRECT;
+#else
+constexpr int kDirectReadFlags = 0;
+#endif
+
+bool UseDirectReads(const EnvOptions& options) {
+  return kDirectReadFlags != 0 && options.use_direct_reads && !options.use_mmap_reads;
+}
+
 class PosixFileLock : public FileLock {
  public:
   int fd_;
@@ -613,13 +623,21 @@ class PosixRocksDBFileFactory : public RocksDBFileFactory {
     result->reset();
     Status s;
     int fd;
+    bool direct_reads = UseDirectReads(options);
     {
       IOSTATS_TIMER_GUARD(open_nanos);
-      fd = open(fname.c_str(), O_RDONLY);
+      fd = open(fname.c_str(), O_RDONLY | (direct_reads ? kDirectReadFlags : 0));
+      if (fd < 0 && direct_reads && errno == EINVAL) {
+        // File system does not support O_DIRECT, fall back to buffered reads.
+        direct_reads = false;
+        fd = open(fname.c_str(), O_RDONLY);
+      }
     }
     SetFD_CLOEXEC(fd, &options);
     if (fd < 0) {
       s = STATUS_IO_ERROR(fname, errno);
+    } else if (direct_reads) {
+      *result = std::make_unique<yb::PosixDirectRandomAccessFile>(fname, fd, options);
     } else if (options.use_mmap_reads && sizeof(void*) >= 8) {
       // Use of mmap for random reads has been removed because it
       // kills performance when storage is fast.
@@ -808,6 +808,36 @@ TEST_F(EnvPosixTest, InvalidateCache) {
   // Delete the file
   ASSERT_OK(env_->DeleteFile(fname));
 }
+
+TEST_F(EnvPosixTest, DirectReads) {
+  constexpr size_t kFileSize = 10000;
+  EnvOptions soptions;
+  std::string fname = test::TmpDir() + "/" + "direct_reads_testfile";
+  std::string data;
+  for (size_t i = 0; i != kFileSize; ++i) {
+    data.push_back('a' + i % 26);
+  }
+  {
+    unique_ptr<WritableFile> wfile;
+    ASSERT_OK(env_->NewWritableFile(fname, &wfile, soptions));
+    ASSERT_OK(wfile->Append(data));
+    ASSERT_OK(wfile->Close());
+  }
+
+  // Reads are not aligned, and could go past the end of file.
+  soptions.use_direct_reads = true;
+  unique_ptr<RandomAccessFile> file;
+  ASSERT_OK(env_->NewRandomAccessFile(fname, &file, soptions));
+  std::string scratch(kFileSize + 1, 0);
+  std::vector<std::pair<size_t, size_t>> reads = {
+      {0, 4096}, {1, 100}, {4000, 200}, {8192, 4096}, {9990, 100}, {0, kFileSize}};
+  for (const auto& read : reads) {
+    Slice result;
+    ASSERT_OK(file->Read(read.first, read.second, &result, &scratch[1]));
+    ASSERT_EQ(data.substr(read.first, read.second), result.ToBuffer());
+  }
+  ASSERT_OK(env_->DeleteFile(fname));
+}
 #endif  // not TRAVIS
 #endif  // __linux__
 
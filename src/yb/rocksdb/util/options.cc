@@ -93,7 +93,8 @@ ImmutableCFOptions::ImmutableCFOptions(const Options& options)
       row_cache(options.row_cache),
       mem_tracker(options.mem_tracker),
       block_based_table_mem_tracker(options.block_based_table_mem_tracker),
-      iterator_replacer(options.iterator_replacer) {}
+      iterator_replacer(options.iterator_replacer),
+      compaction_output_path_selector(options.compaction_output_path_selector) {}
 
 ColumnFamilyOptions::ColumnFamilyOptions()
     : comparator(BytewiseComparator()),
@@ -324,6 +325,7 @@ void DBOptions::Dump(Logger* log) const {
            recycle_log_file_num);
   RHEADER(log, "       Options.allow_os_buffer: %d", allow_os_buffer);
   RHEADER(log, "      Options.allow_mmap_reads: %d", allow_mmap_reads);
+  RHEADER(log, "      Options.use_direct_reads: %d", use_direct_reads);
   RHEADER(log, "      Options.allow_fallocate: %d", allow_fallocate);
   RHEADER(log, "     Options.allow_mmap_writes: %d", allow_mmap_writes);
   RHEADER(log, "         Options.create_missing_column_families: %d",
@@ -401,6 +403,8 @@ void DBOptions::Dump(Logger* log) const {
       enable_thread_tracking);
   RHEADER(log, "         Options.allow_concurrent_memtable_write: %d",
       allow_concurrent_memtable_write);
+  RHEADER(log, "                Options.max_memtable_insert_parts: %" ROCKSDB_PRIszt,
+      memtable_insert_pool ? max_memtable_insert_parts : 1);
   RHEADER(log, "      Options.enable_write_thread_adaptive_yield: %d",
       enable_write_thread_adaptive_yield);
   RHEADER(log, "             Options.write_thread_max_yield_usec: %" PRIu64,
@@ -457,6 +461,8 @@ void ColumnFamilyOptions::Dump(Logger* log) const {
       compression_opts.level);
   RHEADER(log, "              Options.compression_opts.strategy: %d",
       compression_opts.strategy);
+  RHEADER(log, "        Options.compression_opts.max_dict_bytes: %" PRIu32,
+      compression_opts.max_dict_bytes);
   RHEADER(log, "     Options.level0_file_num_compaction_trigger: %d",
       level0_file_num_compaction_trigger);
   RHEADER(log, "         Options.level0_slowdown_writes_trigger: %d",
@@ -188,6 +188,9 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"allow_os_buffer",
      {offsetof(struct DBOptions, allow_os_buffer), OptionType::kBoolean,
       OptionVerificationType::kNormal}},
+    {"use_direct_reads",
+     {offsetof(struct DBOptions, use_direct_reads), OptionType::kBoolean,
+      OptionVerificationType::kNormal}},
     {"create_if_missing",
      {offsetof(struct DBOptions, create_if_missing), OptionType::kBoolean,
       OptionVerificationType::kNormal}},
@@ -320,6 +323,12 @@ static std::unordered_map<std::string, OptionTypeInfo> db_options_type_info = {
     {"allow_concurrent_memtable_write",
      {offsetof(struct DBOptions, allow_concurrent_memtable_write),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"max_memtable_insert_parts",
+     {offsetof(struct DBOptions, max_memtable_insert_parts),
+      OptionType::kSizeT, OptionVerificationType::kNormal}},
+    {"min_entries_per_memtable_insert_part",
+     {offsetof(struct DBOptions, min_entries_per_memtable_insert_part),
+      OptionType::kSizeT, OptionVerificationType::kNormal}},
     {"wal_recovery_mode",
      {offsetof(struct DBOptions, wal_recovery_mode),
       OptionType::kWALRecoveryMode, OptionVerificationType::kNormal}},
@@ -522,6 +531,9 @@ static std::unordered_map<std::string,
     {"cache_index_and_filter_blocks",
      {offsetof(struct BlockBasedTableOptions, cache_index_and_filter_blocks),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"cache_index_and_filter_blocks_with_high_priority",
+     {offsetof(struct BlockBasedTableOptions, cache_index_and_filter_blocks_with_high_priority),
+      OptionType::kBoolean, OptionVerificationType::kNormal}},
     {"index_type",
      {offsetof(struct BlockBasedTableOptions, index_type),
       OptionType::kBlockBasedTableIndexType, OptionVerificationType::kNormal}},
@@ -564,6 +576,9 @@ static std::unordered_map<std::string,
     {"skip_table_builder_flush",
      {offsetof(struct BlockBasedTableOptions, skip_table_builder_flush),
       OptionType::kBoolean, OptionVerificationType::kNormal}},
+    {"max_prefetched_data_blocks",
+     {offsetof(struct BlockBasedTableOptions, max_prefetched_data_blocks),
+      OptionType::kSizeT, OptionVerificationType::kNormal}},
     {"format_version",
      {offsetof(struct BlockBasedTableOptions, format_version),
       OptionType::kUInt32T, OptionVerificationType::kNormal}}};
@@ -127,7 +127,7 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
        "kLZ4Compression:"
        "kLZ4HCCompression:"
        "kZSTDNotFinalCompression"},
-      {"compression_opts", "4:5:6"},
+      {"compression_opts", "4:5:6:7"},
       {"num_levels", "7"},
       {"level0_file_num_compaction_trigger", "8"},
       {"level0_slowdown_writes_trigger", "9"},
@@ -223,6 +223,7 @@ TEST_F(OptionsTest, GetOptionsFromMapTest) {
   ASSERT_EQ(new_cf_opt.compression_opts.window_bits, 4);
   ASSERT_EQ(new_cf_opt.compression_opts.level, 5);
   ASSERT_EQ(new_cf_opt.compression_opts.strategy, 6);
+  ASSERT_EQ(new_cf_opt.compression_opts.max_dict_bytes, 7);
   ASSERT_EQ(new_cf_opt.num_levels, 7);
   ASSERT_EQ(new_cf_opt.level0_file_num_compaction_trigger, 8);
   ASSERT_EQ(new_cf_opt.level0_slowdown_writes_trigger, 9);
@@ -1613,13 +1614,13 @@ void InitDefault(BlockBasedTableOptions*) {}
 
 Status GetFromString(BlockBasedTableOptions* source, BlockBasedTableOptions* destination) {
   const char* const kOptionsString =
-      "cache_index_and_filter_blocks=1;index_type=kHashSearch;"
-      "checksum=kxxHash;hash_index_allow_collision=1;no_block_cache=1;"
+      "cache_index_and_filter_blocks=1;cache_index_and_filter_blocks_with_high_priority=1;"
+      "index_type=kHashSearch;checksum=kxxHash;hash_index_allow_collision=1;no_block_cache=1;"
       "block_cache=1M;block_cache_compressed=1k;block_size=1024;filter_block_size=16384;"
       "block_size_deviation=8;block_restart_interval=4; "
       "index_block_restart_interval=4;index_block_size=16384;min_keys_per_index_block=16;"
       "filter_policy=bloomfilter:4:true;whole_key_filtering=1;"
-      "skip_table_builder_flush=1;format_version=1;"
+      "skip_table_builder_flush=1;max_prefetched_data_blocks=4;format_version=1;"
       "hash_index_allow_collision=false;";
 
   RETURN_NOT_OK(GetBlockBasedTableOptionsFromString(*source, kOptionsString, destination));
@@ -1674,6 +1675,7 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "create_if_missing=true;"
       "error_if_exists=true;"
       "allow_os_buffer=true;"
+      "use_direct_reads=true;"
       "delayed_write_rate=4294976214;"
       "manifest_preallocation_size=1222;"
       "allow_mmap_writes=true;"
@@ -1685,6 +1687,8 @@ Status GetFromString(DBOptions* source, DBOptions* destination) {
       "advise_random_on_open=true;"
       "fail_if_options_file_error=true;"
       "allow_concurrent_memtable_write=true;"
+      "max_memtable_insert_parts=7;"
+      "min_entries_per_memtable_insert_part=1024;"
       "wal_recovery_mode=kPointInTimeRecovery;"
       "enable_write_thread_adaptive_yield=true;"
       "write_thread_slow_yield_usec=5;"
@@ -1892,6 +1896,7 @@ TEST_F(OptionsParserTest, BlockBasedTableOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(BlockBasedTableOptions, block_cache_compressed),
       BLACKLIST_ENTRY(BlockBasedTableOptions, filter_policy),
       BLACKLIST_ENTRY(BlockBasedTableOptions, supported_filter_policies),
+      BLACKLIST_ENTRY(BlockBasedTableOptions, data_block_prefetch_pool),
   };
 
   // In this test, we catch a new option of BlockBasedTableOptions that is not
@@ -1924,6 +1929,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, wal_dir),
       BLACKLIST_ENTRY(DBOptions, memory_monitor),
       BLACKLIST_ENTRY(DBOptions, listeners),
+      BLACKLIST_ENTRY(DBOptions, memtable_insert_pool),
       BLACKLIST_ENTRY(DBOptions, row_cache),
       BLACKLIST_ENTRY(DBOptions, wal_filter),
       BLACKLIST_ENTRY(DBOptions, boundary_extractor),
@@ -1932,6 +1938,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, mem_tracker),
       BLACKLIST_ENTRY(DBOptions, block_based_table_mem_tracker),
       BLACKLIST_ENTRY(DBOptions, iterator_replacer),
+      BLACKLIST_ENTRY(DBOptions, compaction_output_path_selector),
   };
 
   TestAllFieldsSettable<DBOptions>(kDBOptionsBlacklist);
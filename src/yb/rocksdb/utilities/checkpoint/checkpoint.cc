@@ -45,6 +45,25 @@
 namespace rocksdb {
 namespace checkpoint {
 
+namespace {
+
+// Live files are reported relative to the DB dir, but table files could be placed to any of
+// db_paths. Returns directory that contains the specified table file.
+std::string TableFileDir(DB* db, const std::string& fname) {
+  auto* env = db->GetCheckpointEnv();
+  if (env->FileExists(db->GetName() + fname).ok()) {
+    return db->GetName();
+  }
+  for (const auto& db_path : db->GetOptions().db_paths) {
+    if (env->FileExists(db_path.path + fname).ok()) {
+      return db_path.path;
+    }
+  }
+  return db->GetName();
+}
+
+} // namespace
+
 // Builds an openable snapshot of RocksDB on the same disk, which
 // accepts an output directory on the same disk, and under the directory
 // (1) hard-linked SST files pointing to existing live SST files
@@ -116,19 +135,26 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
-    if (is_table_file && same_fs) {
+    const std::string src_dir = is_table_file ? TableFileDir(db, src_fname) : db->GetName();
+    // Files from other db_paths could be located on another device, so failure to link them
+    // should not turn off linking of files from the DB dir.
+    bool copy_file = !is_table_file || !same_fs;
+    if (!copy_file) {
       RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
-      s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
+      s = db->GetCheckpointEnv()->LinkFile(src_dir + src_fname,
                                  full_private_path + src_fname);
       if (s.IsNotSupported()) {
-        same_fs = false;
+        if (src_dir == db->GetName()) {
+          same_fs = false;
+        }
+        copy_file = true;
         s = Status::OK();
       }
     }
-    if (!is_table_file || !same_fs) {
+    if (copy_file) {
       RLOG(db->GetOptions().info_log, "Copying %s", src_fname.c_str());
       std::string dest_name = full_private_path + src_fname;
-      s = CopyFile(db->GetCheckpointEnv(), db->GetName() + src_fname, dest_name,
+      s = CopyFile(db->GetCheckpointEnv(), src_dir + src_fname, dest_name,
                    type == kDescriptorFile ? manifest_file_size : 0);
     }
   }
@@ -288,6 +288,10 @@ class StackableDB : public DB {
     return db_->GetMiddleKey();
   };
 
+  yb::Result<std::vector<std::string>> GetSplitKeys(size_t num_parts) override {
+    return db_->GetSplitKeys(num_parts);
+  }
+
   virtual void GetColumnFamilyMetaData(
       ColumnFamilyHandle *column_family,
       ColumnFamilyMetaData* cf_meta) override {
@@ -76,10 +76,14 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
                                               bool is_explicit_request_read_time,
                                               const PgsqlReadRequestPB& pgsql_read_request,
                                               const TransactionOperationContextOpt& txn_op_context,
+                                              docdb::PgsqlParallelScan* parallel_scan,
                                               PgsqlReadRequestResult* result,
                                               size_t* num_rows_read) {
 
   docdb::PgsqlReadOperation doc_op(pgsql_read_request, txn_op_context);
+  if (parallel_scan) {
+    doc_op.SetParallelScan(std::move(*parallel_scan));
+  }
 
   // Form a schema of columns that are referenced by this query.
   const SchemaPtr schema = GetSchema(pgsql_read_request.table_id());
@@ -19,6 +19,7 @@
 #include "yb/common/ql_storage_interface.h"
 #include "yb/common/redis_protocol.pb.h"
 #include "yb/common/schema.h"
+#include "yb/docdb/docdb_fwd.h"
 
 #include "yb/tablet/tablet_fwd.h"
 
@@ -127,6 +128,7 @@ class AbstractTablet {
                                         bool is_explicit_request_read_time,
                                         const PgsqlReadRequestPB& pgsql_read_request,
                                         const TransactionOperationContextOpt& txn_op_context,
+                                        docdb::PgsqlParallelScan* parallel_scan,
                                         PgsqlReadRequestResult* result,
                                         size_t* num_rows_read);
 
@@ -17,6 +17,8 @@
 
 #include "yb/common/pgsql_error.h"
 
+#include "yb/tablet/transaction_status_batcher.h"
+
 #include "yb/util/flag_tags.h"
 #include "yb/util/tsan_util.h"
 #include "yb/util/yb_pg_errcodes.h"
@@ -199,6 +201,14 @@ boost::optional<TransactionStatus> RunningTransaction::GetStatusAt(
 
 void RunningTransaction::SendStatusRequest(
     int64_t serial_no, const RunningTransactionPtr& shared_self) {
+  auto* status_batcher = context_.participant_context_.status_batcher();
+  if (status_batcher) {
+    // Status requests of all tablets of this tablet server are coalesced by the batcher.
+    status_batcher->RequestStatus(
+        &context_, metadata_.status_tablet, metadata_.transaction_id,
+        std::bind(&RunningTransaction::StatusReceived, this, _1, _2, serial_no, shared_self));
+    return;
+  }
   tserver::GetTransactionStatusRequestPB req;
   req.set_tablet_id(metadata_.status_tablet);
   req.add_transaction_id()->assign(
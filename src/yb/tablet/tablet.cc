@@ -49,8 +49,10 @@
 
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/options.h"
 #include "yb/rocksdb/statistics.h"
+#include "yb/rocksdb/table.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
 #include "yb/rocksdb/write_batch.h"
 #include "yb/rocksdb/util/file_util.h"
@@ -219,6 +221,11 @@ DEFINE_test_flag(bool, docdb_log_write_batches, false,
 DEFINE_test_flag(bool, export_intentdb_metrics, false,
                  "Dump intentsdb statistics to prometheus metrics");
 
+DEFINE_int32(pgsql_parallel_scan_max_parts, 8,
+             "The maximum number of key ranges scanned in parallel by a single YSQL aggregate read "
+             "request, when the parallel scan thread pool is enabled.");
+TAG_FLAG(pgsql_parallel_scan_max_parts, advanced);
+
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
@@ -481,6 +488,8 @@ Tablet::Tablet(const TabletInitData& data)
         });
 
     metrics_.reset(new TabletMetrics(metric_entity_));
+    shared_lock_manager_.SetMetrics(
+        metrics_->write_lock_waits, metrics_->write_lock_stripe_contentions);
 
     mem_tracker_->SetMetricEntity(metric_entity_);
   }
@@ -695,6 +704,11 @@ Status Tablet::OpenKeyValueTablet() {
   if (metric_entity_) {
     rocksdb_options.block_based_table_mem_tracker->SetMetricEntity(metric_entity_,
         Format("$0_$1", "BlockBasedTable", kRegularDB));
+    // Memory used by bloom filters is also exposed separately.
+    MemTracker::FindOrCreateTracker(
+        rocksdb::kFilterBlocksMemTrackerId, rocksdb_options.block_based_table_mem_tracker,
+        AddToParent::kTrue, CreateMetrics::kFalse)->SetMetricEntity(metric_entity_,
+            Format("$0_$1", "BlockBasedTable", kRegularDB));
   }
 
   key_bounds_ = docdb::KeyBounds(metadata()->lower_bound_key(), metadata()->upper_bound_key());
@@ -718,10 +732,28 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options regular_rocksdb_options(rocksdb_options);
   regular_rocksdb_options.listeners.push_back(
       std::make_shared<RegularRocksDbListener>(this, regular_rocksdb_options.log_prefix));
+  if (tablet_options_.memtable_insert_pool) {
+    // Raft applies batches of a tablet one by one, so large batches are split between threads.
+    // Only the regular DB is affected, since the intents DB relies on in-memory erase, that is not
+    // supported by the concurrent memtable.
+    // allow_concurrent_memtable_write stays off, since parallel insert of write batch groups does
+    // not preserve the order of frontiers.
+    regular_rocksdb_options.memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+        0 /* lookahead */, rocksdb::ConcurrentWrites::kTrue);
+    regular_rocksdb_options.memtable_insert_pool = tablet_options_.memtable_insert_pool;
+  }
 
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
 
+  const string cold_data_dir = docdb::ColdDataDir(db_dir);
+  if (!cold_data_dir.empty()) {
+    // RocksDB creates only the last component of its data paths.
+    RETURN_NOT_OK_PREPEND(metadata()->fs_manager()->env()->CreateDirs(DirName(cold_data_dir)),
+                          Format("Failed to create cold data directory $0", cold_data_dir));
+    docdb::SetColdDataPath(db_dir, &regular_rocksdb_options);
+  }
+
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
   rocksdb::Status rocksdb_open_status = rocksdb::DB::Open(regular_rocksdb_options, db_dir, &db);
@@ -758,6 +790,10 @@ Status Tablet::OpenKeyValueTablet() {
     if (metric_entity_) {
       intents_rocksdb_options.block_based_table_mem_tracker->SetMetricEntity(metric_entity_,
         Format("$0_$1", "BlockBasedTable", kIntentsDB));
+      MemTracker::FindOrCreateTracker(
+          rocksdb::kFilterBlocksMemTrackerId, intents_rocksdb_options.block_based_table_mem_tracker,
+          AddToParent::kTrue, CreateMetrics::kFalse)->SetMetricEntity(metric_entity_,
+              Format("$0_$1", "BlockBasedTable", kIntentsDB));
     }
     intents_rocksdb_options.statistics = intentsdb_statistics_;
 
@@ -1654,9 +1690,23 @@ Status Tablet::HandlePgsqlReadRequest(
           transaction_metadata,
           table_info->schema.table_properties().is_ysql_catalog_table());
   RETURN_NOT_OK(txn_op_ctx);
+
+  docdb::PgsqlParallelScan parallel_scan;
+  if (tablet_options_.parallel_scan_pool && FLAGS_pgsql_parallel_scan_max_parts > 1 &&
+      docdb::PgsqlReadOperation::IsParallelScanSupported(pgsql_read_request, table_info->schema)) {
+    auto split_keys = GetEncodedScanSplitKeys(FLAGS_pgsql_parallel_scan_max_parts);
+    if (split_keys.ok()) {
+      parallel_scan.pool = tablet_options_.parallel_scan_pool;
+      parallel_scan.split_keys = std::move(*split_keys);
+    } else {
+      // Split keys are not available before the first flush, the tablet is scanned sequentially.
+      VLOG_WITH_PREFIX(1) << "Failed to get scan split keys: " << split_keys.status();
+    }
+  }
+
   return AbstractTablet::HandlePgsqlReadRequest(
       deadline, read_time, is_explicit_request_read_time,
-      pgsql_read_request, *txn_op_ctx, result, num_rows_read);
+      pgsql_read_request, *txn_op_ctx, &parallel_scan, result, num_rows_read);
 }
 
 // Returns true if the query can be satisfied by rows present in current tablet.
@@ -1952,9 +2002,13 @@ Result<docdb::ApplyTransactionState> Tablet::ApplyIntents(const TransactionApply
   VLOG_WITH_PREFIX(4) << __func__ << ": " << data.transaction_id;
 
   rocksdb::WriteBatch regular_write_batch;
+  // The first batch is applied by the Raft apply thread, so its intents are not looked up by the
+  // apply intents pool, to avoid blocking this thread on the pool. Following batches are applied
+  // by ApplyIntentsTask.
   auto new_apply_state = VERIFY_RESULT(docdb::PrepareApplyIntentsBatch(
       data.transaction_id, data.commit_ht, &key_bounds_, data.apply_state,
-      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */));
+      &regular_write_batch, intents_db_.get(), nullptr /* intents_write_batch */,
+      data.apply_state ? tablet_options_.apply_intents_pool : nullptr));
 
   // data.hybrid_time contains transaction commit time.
   // We don't set transaction field of put_batch, otherwise we would write another bunch of intents.
@@ -2852,6 +2906,7 @@ class DocWriteOperation : public std::enable_shared_from_this<DocWriteOperation>
         read_time_ ? read_time_.read : HybridTime::kMax,
         tablet_.doc_db(), partial_range_key_intents,
         transaction_participant, tablet_.metrics()->transaction_conflicts.get(),
+        &prepare_result_.lock_batch, operation_->deadline(),
         [self = shared_from_this()](const Result<HybridTime>& result) {
           if (!result.ok()) {
             self->InvokeCallback(result.status());
@@ -3325,6 +3380,29 @@ Result<std::string> Tablet::GetEncodedMiddleSplitKey() const {
   return middle_key;
 }
 
+Result<std::vector<std::string>> Tablet::GetEncodedScanSplitKeys(size_t num_parts) const {
+  auto keys = VERIFY_RESULT(regular_db_->GetSplitKeys(num_parts));
+  std::vector<std::string> result;
+  result.reserve(keys.size());
+  for (auto& key : keys) {
+    const auto doc_key_size = VERIFY_RESULT(
+        DocKey::EncodedSize(key, docdb::DocKeyPart::kWholeDocKey));
+    key.resize(doc_key_size);
+    const Slice key_slice(key);
+    // Keys outside of key_bounds_ could be present in post-split tablet before it is compacted.
+    if (key_slice.compare(key_bounds_.lower) <= 0 ||
+        (!key_bounds_.upper.empty() && key_slice.compare(key_bounds_.upper) >= 0)) {
+      continue;
+    }
+    // Several split keys could belong to the same row.
+    if (!result.empty() && result.back() == key) {
+      continue;
+    }
+    result.push_back(std::move(key));
+  }
+  return result;
+}
+
 // ------------------------------------------------------------------------------------------------
 
 Result<ScopedReadOperation> ScopedReadOperation::Create(
@@ -536,6 +536,11 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // - for range-based partitions: encoded doc key in order to split by row.
   Result<std::string> GetEncodedMiddleSplitKey() const;
 
+  // Returns up to num_parts - 1 encoded doc keys, in ascending order, that split the tablet
+  // into approximately equally sized key ranges. Could be used to scan the tablet by several
+  // independent sub range scans, e.g. for parallel scans or index backfill.
+  Result<std::vector<std::string>> GetEncodedScanSplitKeys(size_t num_parts) const;
+
   std::string TEST_DocDBDumpStr(IncludeIntents include_intents = IncludeIntents::kFalse);
 
   void TEST_DocDBDumpToContainer(
@@ -50,6 +50,7 @@ class TransactionCoordinator;
 class TransactionCoordinatorContext;
 class TransactionParticipant;
 class TransactionParticipantContext;
+class TransactionStatusBatcher;
 class UpdateTxnOperationState;
 class WriteOperationState;
 
@@ -425,6 +425,12 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb data directory " << rocksdb_dir;
   }
 
+  const auto cold_data_dir = docdb::ColdDataDir(rocksdb_dir);
+  if (!cold_data_dir.empty() && fs_manager_->env()->FileExists(cold_data_dir)) {
+    auto s = fs_manager_->env()->DeleteRecursively(cold_data_dir);
+    LOG_IF(WARNING, !s.ok()) << "Unable to delete cold data directory " << cold_data_dir;
+  }
+
   const auto intents_dir = this->intents_rocksdb_dir();
   if (fs_manager_->env()->FileExists(intents_dir)) {
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
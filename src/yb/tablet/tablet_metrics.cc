@@ -124,6 +124,16 @@ METRIC_DEFINE_counter(tablet, transaction_conflicts,
   yb::MetricUnit::kRequests,
   "Number of conflicts detected among uncommitted distributed transactions.");
 
+METRIC_DEFINE_counter(tablet, write_lock_waits,
+  "Write Lock Waits",
+  yb::MetricUnit::kRequests,
+  "Number of write lock batches that had to wait for conflicting locks on the same keys.");
+
+METRIC_DEFINE_counter(tablet, write_lock_stripe_contentions,
+  "Write Lock Stripe Contentions",
+  yb::MetricUnit::kRequests,
+  "Number of times a stripe of the write lock table was busy when locking or unlocking a key.");
+
 METRIC_DEFINE_counter(tablet, expired_transactions,
   "Expired Distributed Transactions",
   yb::MetricUnit::kRequests,
@@ -160,6 +170,8 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(leader_memory_pressure_rejections),
     MINIT(majority_sst_files_rejections),
     MINIT(transaction_conflicts),
+    MINIT(write_lock_waits),
+    MINIT(write_lock_stripe_contentions),
     MINIT(expired_transactions),
     MINIT(restart_read_requests),
     MINIT(consistent_prefix_read_requests),
@@ -64,6 +64,8 @@ struct TabletMetrics {
   scoped_refptr<Counter> leader_memory_pressure_rejections;
   scoped_refptr<Counter> majority_sst_files_rejections;
   scoped_refptr<Counter> transaction_conflicts;
+  scoped_refptr<Counter> write_lock_waits;
+  scoped_refptr<Counter> write_lock_stripe_contentions;
   scoped_refptr<Counter> expired_transactions;
   scoped_refptr<Counter> restart_read_requests;
   scoped_refptr<Counter> consistent_prefix_read_requests;
@@ -36,6 +36,7 @@ namespace yb {
 
 class Env;
 class MetricRegistry;
+class ThreadPool;
 
 namespace log {
 
@@ -49,10 +50,22 @@ YB_STRONGLY_TYPED_BOOL(IsDropTable);
 
 struct TabletOptions {
   std::shared_ptr<rocksdb::Cache> block_cache;
+  // Optional secondary cache of compressed blocks, that is looked up on block_cache miss.
+  std::shared_ptr<rocksdb::Cache> block_cache_compressed;
   std::shared_ptr<rocksdb::MemoryMonitor> memory_monitor;
   std::vector<std::shared_ptr<rocksdb::EventListener>> listeners;
   yb::Env* env = Env::Default();
   rocksdb::Env* rocksdb_env = rocksdb::Env::Default();
+  // Optional thread pool used to insert large write batches into the regular DB memtable in
+  // parallel.
+  ThreadPool* memtable_insert_pool = nullptr;
+  // Optional thread pool used to prefetch data blocks into the block cache during sequential
+  // scans.
+  ThreadPool* data_block_prefetch_pool = nullptr;
+  // Optional thread pool used to look up intents of large transactions in parallel during apply.
+  ThreadPool* apply_intents_pool = nullptr;
+  // Optional thread pool used to scan key ranges of a tablet in parallel for YSQL aggregates.
+  ThreadPool* parallel_scan_pool = nullptr;
 };
 
 struct TabletInitData {
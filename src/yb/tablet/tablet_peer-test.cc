@@ -132,7 +132,8 @@ class TabletPeerTest : public YBTabletTest {
             tablet()->tablet_id()),
         &metric_registry_,
         nullptr, // tablet_splitter
-        std::shared_future<client::YBClient*>()));
+        std::shared_future<client::YBClient*>(),
+        nullptr /* status_batcher */));
 
     // Make TabletPeer use the same LogAnchorRegistry as the Tablet created by the harness.
     // TODO: Refactor TabletHarness to allow taking a LogAnchorRegistry, while also providing
@@ -141,6 +141,7 @@ class TabletPeer : public consensus::ConsensusContext,
 
   // Creates TabletPeer.
   // `tablet_splitter` will be used for applying split tablet Raft operation.
+  // `status_batcher` is tablet server wide service for transaction status requests, could be null.
   TabletPeer(
       const RaftGroupMetadataPtr& meta,
       const consensus::RaftPeerPB& local_peer_pb,
@@ -149,7 +150,8 @@ class TabletPeer : public consensus::ConsensusContext,
       Callback<void(std::shared_ptr<StateChangeContext> context)> mark_dirty_clbk,
       MetricRegistry* metric_registry,
       TabletSplitter* tablet_splitter,
-      const std::shared_future<client::YBClient*>& client_future);
+      const std::shared_future<client::YBClient*>& client_future,
+      TransactionStatusBatcher* status_batcher);
 
   ~TabletPeer();
 
@@ -331,6 +333,10 @@ class TabletPeer : public consensus::ConsensusContext,
     return client_future_;
   }
 
+  TransactionStatusBatcher* status_batcher() const override {
+    return status_batcher_;
+  }
+
   int64_t LeaderTerm() const override;
   consensus::LeaderStatus LeaderStatus(bool allow_stale = false) const;
 
@@ -491,6 +497,7 @@ class TabletPeer : public consensus::ConsensusContext,
   uint64_t NumSSTFiles() override;
   void ListenNumSSTFilesChanged(std::function<void()> listener) override;
   rpc::Scheduler& scheduler() const override;
+  rpc::ThreadPool& thread_pool() const override;
 
   MetricRegistry* metric_registry_;
 
@@ -507,6 +514,8 @@ class TabletPeer : public consensus::ConsensusContext,
 
   std::shared_future<client::YBClient*> client_future_;
 
+  TransactionStatusBatcher* status_batcher_;
+
   rpc::Messenger* messenger_;
 
   DISALLOW_COPY_AND_ASSIGN(TabletPeer);
@@ -17,6 +17,7 @@
 
 #include <mutex>
 #include <queue>
+#include <unordered_map>
 
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -49,6 +50,7 @@
 #include "yb/tablet/running_transaction.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/transaction_loader.h"
+#include "yb/tablet/transaction_status_batcher.h"
 #include "yb/tablet/transaction_status_resolver.h"
 
 #include "yb/tserver/tserver_service.pb.h"
@@ -114,6 +116,54 @@ namespace {
 
 YB_STRONGLY_TYPED_BOOL(PostApplyCleanup);
 
+// Callback registered by TransactionStatusManager::WaitForTransaction, that is fired when
+// transaction stops running or when deadline is reached.
+class TransactionWaiter {
+ public:
+  explicit TransactionWaiter(std::function<void(const Status&)> callback)
+      : callback_(std::move(callback)) {}
+
+  void Fire(const Status& status) {
+    bool expected = false;
+    if (fired_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+      callback_(status);
+    }
+  }
+
+  bool fired() const {
+    return fired_.load(std::memory_order_acquire);
+  }
+
+ private:
+  std::function<void(const Status&)> callback_;
+  std::atomic<bool> fired_{false};
+};
+
+using TransactionWaiterPtr = std::shared_ptr<TransactionWaiter>;
+
+// Fires waiter on thread pool, since its callback could block.
+// When the task could not be run, for instance because of shutdown, waiter is fired with failure.
+class FireTransactionWaiterTask : public rpc::ThreadPoolTask {
+ public:
+  explicit FireTransactionWaiterTask(TransactionWaiterPtr waiter) : waiter_(std::move(waiter)) {}
+
+  void Run() override {
+    waiter_->Fire(Status::OK());
+  }
+
+  void Done(const Status& status) override {
+    if (!status.ok()) {
+      waiter_->Fire(status);
+    }
+    delete this;
+  }
+
+ private:
+  virtual ~FireTransactionWaiterTask() = default;
+
+  TransactionWaiterPtr waiter_;
+};
+
 } // namespace
 
 std::string TransactionApplyData::ToString() const {
@@ -164,14 +214,24 @@ class TransactionParticipant::Impl
     LOG_IF_WITH_PREFIX(DFATAL, !closing_.load()) << __func__ << " w/o StartShutdown";
 
     decltype(status_resolvers_) status_resolvers;
+    decltype(waiters_) waiters;
     {
       MinRunningNotifier min_running_notifier(nullptr /* applier */);
       std::lock_guard<std::mutex> lock(mutex_);
       transactions_.clear();
       TransactionsModifiedUnlocked(&min_running_notifier);
       status_resolvers.swap(status_resolvers_);
+      waiters.swap(waiters_);
     }
 
+    for (auto& id_and_waiter : waiters) {
+      id_and_waiter.second->Fire(STATUS(Aborted, "Transaction participant shutdown"));
+    }
+
+    auto* status_batcher = participant_context_.status_batcher();
+    if (status_batcher) {
+      status_batcher->Abort(static_cast<RunningTransactionContext*>(this));
+    }
     rpcs_.Shutdown();
     loader_.Shutdown();
     for (auto& resolver : status_resolvers) {
@@ -433,6 +493,38 @@ class TransactionParticipant::Impl
     }
   }
 
+  void WaitForTransaction(
+      const TransactionId& id, CoarseTimePoint deadline,
+      std::function<void(const Status&)> callback) {
+    auto waiter = std::make_shared<TransactionWaiter>(std::move(callback));
+    loader_.WaitLoaded(id);
+    auto now = CoarseMonoClock::now();
+    auto fire_time = now;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (Closing()) {
+        participant_context_.scheduler().Schedule(
+            [waiter](const Status&) {
+              waiter->Fire(STATUS(Aborted, "Transaction participant shutdown"));
+            },
+            std::chrono::steady_clock::duration::zero());
+        return;
+      }
+      if (WasTransactionRecentlyRemoved(id)) {
+        // Fire immediately.
+      } else if (transactions_.find(id) != transactions_.end()) {
+        waiters_.emplace(id, waiter);
+        fire_time = deadline;
+      } else {
+        // Transaction is not known to this tablet, so we would not be notified when it finishes.
+        // Recheck it later instead of waiting until deadline.
+        fire_time = std::min<CoarseTimePoint>(
+            deadline, now + std::chrono::milliseconds(FLAGS_transactions_status_poll_interval_ms));
+      }
+    }
+    ScheduleFire(waiter, fire_time - now);
+  }
+
   void Handle(std::unique_ptr<tablet::UpdateTxnOperationState> state, int64_t term) {
     auto txn_status = state->request()->status();
     if (txn_status == TransactionStatus::APPLYING) {
@@ -1199,10 +1291,38 @@ class TransactionParticipant::Impl
     LOG_IF_WITH_PREFIX(DFATAL, !recently_removed_transactions_.insert(transaction.id()).second)
         << "Transaction removed twice: " << transaction.id();
     VLOG_WITH_PREFIX(4) << "Remove transaction: " << transaction.id();
+    NotifyWaitersUnlocked(transaction.id());
     transactions_.erase(it);
     TransactionsModifiedUnlocked(min_running_notifier);
   }
 
+  // Waiters are fired asynchronously, so they are not invoked while holding mutex_.
+  void NotifyWaitersUnlocked(const TransactionId& id) REQUIRES(mutex_) {
+    auto range = waiters_.equal_range(id);
+    for (auto it = range.first; it != range.second; ++it) {
+      ScheduleFire(it->second, CoarseDuration::zero());
+    }
+    waiters_.erase(range.first, range.second);
+  }
+
+  // Scheduler only tracks the delay, the waiter itself is fired on the thread pool, since it
+  // continues conflict resolution, that could block.
+  // Thread pool is owned by messenger, as the scheduler, so it outlives scheduled task, while this
+  // object could be destroyed before it.
+  void ScheduleFire(const TransactionWaiterPtr& waiter, CoarseDuration delay) {
+    auto* thread_pool = &participant_context_.thread_pool();
+    participant_context_.scheduler().Schedule(
+        [waiter, thread_pool](const Status& status) {
+          if (!status.ok()) {
+            waiter->Fire(status);
+            return;
+          }
+          thread_pool->Enqueue(new FireTransactionWaiterTask(waiter));
+        },
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::max(delay, CoarseDuration::zero())));
+  }
+
   void CleanupRecentlyRemovedTransactions(CoarseTimePoint now) {
     while (!recently_removed_transactions_cleanup_queue_.empty() &&
            recently_removed_transactions_cleanup_queue_.front().time <= now) {
@@ -1330,10 +1450,24 @@ class TransactionParticipant::Impl
       if (ANNOTATE_UNPROTECTED_READ(FLAGS_transactions_poll_check_aborted)) {
         CheckForAbortedTransactions();
       }
+      CleanupFiredWaitersUnlocked();
     }
     CleanupStatusResolvers();
   }
 
+  // Removes waiters that were fired by deadline, while transaction they are waiting for is still
+  // running. Deadline is fired from scheduler, that could outlive this object, so it does not
+  // touch waiters_ itself.
+  void CleanupFiredWaitersUnlocked() REQUIRES(mutex_) {
+    for (auto it = waiters_.begin(); it != waiters_.end();) {
+      if (it->second->fired()) {
+        it = waiters_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
   void CheckForAbortedTransactions() REQUIRES(mutex_) {
     if (transactions_.empty()) {
       return;
@@ -1455,6 +1589,10 @@ class TransactionParticipant::Impl
   std::mutex status_resolvers_mutex_;
   std::deque<TransactionStatusResolver> status_resolvers_ GUARDED_BY(status_resolvers_mutex_);
 
+  // Waiters registered by WaitForTransaction, keyed by id of the transaction they are waiting for.
+  std::unordered_multimap<TransactionId, TransactionWaiterPtr, TransactionIdHash> waiters_
+      GUARDED_BY(mutex_);
+
   scoped_refptr<AtomicGauge<uint64_t>> metric_transactions_running_;
   scoped_refptr<Counter> metric_transaction_not_found_;
 
@@ -1579,6 +1717,12 @@ HybridTime TransactionParticipant::MinRunningHybridTime() const {
   return impl_->MinRunningHybridTime();
 }
 
+void TransactionParticipant::WaitForTransaction(
+    const TransactionId& id, CoarseTimePoint deadline,
+    std::function<void(const Status&)> callback) {
+  impl_->WaitForTransaction(id, deadline, std::move(callback));
+}
+
 void TransactionParticipant::WaitMinRunningHybridTime(HybridTime ht) {
   impl_->WaitMinRunningHybridTime(ht);
 }
@@ -107,8 +107,12 @@ class TransactionParticipantContext {
   virtual const std::string& permanent_uuid() const = 0;
   virtual const std::string& tablet_id() const = 0;
   virtual const std::shared_future<client::YBClient*>& client_future() const = 0;
+  // Tablet server wide service for transaction status requests, null if not available.
+  virtual TransactionStatusBatcher* status_batcher() const = 0;
   virtual const server::ClockPtr& clock_ptr() const = 0;
   virtual rpc::Scheduler& scheduler() const = 0;
+  // Thread pool for tasks that could block, so they should not be run on the scheduler.
+  virtual rpc::ThreadPool& thread_pool() const = 0;
 
   // Fills RemoveIntentsData with information about replicated state.
   virtual void GetLastReplicatedData(RemoveIntentsData* data) = 0;
@@ -217,6 +221,10 @@ class TransactionParticipant : public TransactionStatusManager {
 
   HybridTime MinRunningHybridTime() const override;
 
+  void WaitForTransaction(
+      const TransactionId& id, CoarseTimePoint deadline,
+      std::function<void(const Status&)> callback) override;
+
   // When minimal start hybrid time of running transaction will be at least `ht` applier
   // method `MinRunningHybridTimeSatisfied` will be invoked.
   void WaitMinRunningHybridTime(HybridTime ht);
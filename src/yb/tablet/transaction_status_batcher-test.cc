@@ -0,0 +1,327 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <deque>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <gtest/gtest.h>
+
+#include "yb/server/logical_clock.h"
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/test_util.h"
+
+DECLARE_int32(max_concurrent_transaction_status_requests_per_tablet);
+DECLARE_int32(transaction_status_cache_ttl_ms);
+DECLARE_uint64(max_transactions_in_status_request);
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const TabletId kStatusTablet = "status_tablet";
+const TabletId kOtherStatusTablet = "other_status_tablet";
+
+struct SentRequest {
+  tserver::GetTransactionStatusRequestPB request;
+  TransactionStatusBatcherCallback callback;
+
+  std::vector<TransactionId> TransactionIds() const {
+    std::vector<TransactionId> result;
+    for (const auto& id : request.transaction_id()) {
+      result.push_back(CHECK_RESULT(FullyDecodeTransactionId(id)));
+    }
+    return result;
+  }
+
+  // Responds with the same status for all transactions of the request.
+  void Respond(TransactionStatus status, HybridTime status_ht = HybridTime(1000)) const {
+    tserver::GetTransactionStatusResponsePB response;
+    for (int i = 0; i != request.transaction_id().size(); ++i) {
+      response.add_status(status);
+      response.add_status_hybrid_time(status_ht.ToUint64());
+    }
+    callback(Status::OK(), response);
+  }
+};
+
+struct ReceivedStatus {
+  Status status;
+  tserver::GetTransactionStatusResponsePB response;
+};
+
+} // namespace
+
+class TransactionStatusBatcherTest : public YBTest {
+ protected:
+  void SetUp() override {
+    YBTest::SetUp();
+    clock_ = server::LogicalClock::CreateStartingAt(HybridTime::kInitial);
+    batcher_ = std::make_unique<TransactionStatusBatcher>(
+        clock_,
+        [this](const tserver::GetTransactionStatusRequestPB& request,
+               TransactionStatusBatcherCallback callback) {
+          sent_.push_back(SentRequest{request, std::move(callback)});
+        });
+  }
+
+  void TearDown() override {
+    batcher_->Shutdown();
+    YBTest::TearDown();
+  }
+
+  // Requests status of transaction and returns index of its result in received_.
+  size_t RequestStatus(
+      const TransactionId& id, const void* owner = nullptr,
+      const TabletId& status_tablet = kStatusTablet) {
+    size_t idx = received_.size();
+    received_.emplace_back();
+    batcher_->RequestStatus(
+        owner ? owner : this, status_tablet, id,
+        [this, idx](const Status& status, const tserver::GetTransactionStatusResponsePB& resp) {
+          ASSERT_FALSE(received_[idx]) << "Callback invoked twice";
+          received_[idx] = ReceivedStatus{status, resp};
+        });
+    return idx;
+  }
+
+  void CheckReceived(size_t idx, TransactionStatus expected) {
+    ASSERT_TRUE(received_[idx]);
+    ASSERT_OK(received_[idx]->status);
+    ASSERT_EQ(received_[idx]->response.status().size(), 1);
+    ASSERT_EQ(received_[idx]->response.status(0), expected);
+  }
+
+  server::ClockPtr clock_;
+  std::unique_ptr<TransactionStatusBatcher> batcher_;
+  // Deque is used, because requests are added while callback of other request is being invoked.
+  std::deque<SentRequest> sent_;
+  std::vector<boost::optional<ReceivedStatus>> received_;
+};
+
+TEST_F(TransactionStatusBatcherTest, Coalesce) {
+  FLAGS_max_concurrent_transaction_status_requests_per_tablet = 1;
+  auto id1 = TransactionId::GenerateRandom();
+  auto id2 = TransactionId::GenerateRandom();
+
+  auto r1 = RequestStatus(id1);
+  ASSERT_EQ(sent_.size(), 1);
+
+  // First request is in flight, so following requests are queued and sent as one batch,
+  // requesting each transaction only once.
+  auto r2 = RequestStatus(id2);
+  auto r3 = RequestStatus(id1);
+  auto r4 = RequestStatus(id2);
+  ASSERT_EQ(sent_.size(), 1);
+  ASSERT_FALSE(received_[r2]);
+
+  sent_[0].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(r1, TransactionStatus::PENDING));
+  ASSERT_EQ(sent_.size(), 2);
+  ASSERT_EQ(sent_[1].request.tablet_id(), kStatusTablet);
+  ASSERT_EQ(sent_[1].TransactionIds(), (std::vector<TransactionId>{id2, id1}));
+
+  // Hybrid time is propagated with each batch, taken when the batch is sent.
+  ASSERT_TRUE(sent_[0].request.has_propagated_hybrid_time());
+  ASSERT_GT(sent_[1].request.propagated_hybrid_time(), sent_[0].request.propagated_hybrid_time());
+
+  sent_[1].Respond(TransactionStatus::PENDING);
+  for (auto idx : {r2, r3, r4}) {
+    ASSERT_NO_FATALS(CheckReceived(idx, TransactionStatus::PENDING));
+  }
+  ASSERT_EQ(sent_.size(), 2);
+}
+
+TEST_F(TransactionStatusBatcherTest, MaxTransactionsInRequest) {
+  FLAGS_max_concurrent_transaction_status_requests_per_tablet = 1;
+  FLAGS_max_transactions_in_status_request = 2;
+  std::vector<TransactionId> ids;
+  for (int i = 0; i != 4; ++i) {
+    ids.push_back(TransactionId::GenerateRandom());
+  }
+
+  RequestStatus(ids[0]);
+  for (const auto& id : ids) {
+    RequestStatus(id);
+  }
+  ASSERT_EQ(sent_.size(), 1);
+
+  sent_[0].Respond(TransactionStatus::PENDING);
+  ASSERT_EQ(sent_.size(), 2);
+  ASSERT_EQ(sent_[1].TransactionIds(), (std::vector<TransactionId>{ids[0], ids[1]}));
+
+  sent_[1].Respond(TransactionStatus::PENDING);
+  ASSERT_EQ(sent_.size(), 3);
+  ASSERT_EQ(sent_[2].TransactionIds(), (std::vector<TransactionId>{ids[2], ids[3]}));
+
+  sent_[2].Respond(TransactionStatus::PENDING);
+  for (const auto& received : received_) {
+    ASSERT_TRUE(received);
+    ASSERT_OK(received->status);
+  }
+}
+
+TEST_F(TransactionStatusBatcherTest, ConcurrentBatches) {
+  FLAGS_max_concurrent_transaction_status_requests_per_tablet = 2;
+  auto id1 = TransactionId::GenerateRandom();
+  auto id2 = TransactionId::GenerateRandom();
+  auto id3 = TransactionId::GenerateRandom();
+
+  // Requests are sent right away until limit of concurrent batches is reached.
+  auto r1 = RequestStatus(id1);
+  auto r2 = RequestStatus(id2);
+  ASSERT_EQ(sent_.size(), 2);
+  auto r3 = RequestStatus(id3);
+  auto r4 = RequestStatus(id1);
+  ASSERT_EQ(sent_.size(), 2);
+
+  // Limit is applied per status tablet.
+  auto r5 = RequestStatus(id3, nullptr /* owner */, kOtherStatusTablet);
+  ASSERT_EQ(sent_.size(), 3);
+  ASSERT_EQ(sent_[2].request.tablet_id(), kOtherStatusTablet);
+
+  // Batch that completes first frees the slot, independently of the order in which they were sent.
+  sent_[1].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(r2, TransactionStatus::PENDING));
+  ASSERT_FALSE(received_[r1]);
+  ASSERT_EQ(sent_.size(), 4);
+  ASSERT_EQ(sent_[3].TransactionIds(), (std::vector<TransactionId>{id3, id1}));
+
+  sent_[3].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(r3, TransactionStatus::PENDING));
+  ASSERT_NO_FATALS(CheckReceived(r4, TransactionStatus::PENDING));
+
+  sent_[0].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(r1, TransactionStatus::PENDING));
+  sent_[2].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(r5, TransactionStatus::PENDING));
+  ASSERT_EQ(sent_.size(), 4);
+}
+
+TEST_F(TransactionStatusBatcherTest, Cache) {
+  FLAGS_transaction_status_cache_ttl_ms = 60000;
+  auto committed_id = TransactionId::GenerateRandom();
+  auto pending_id = TransactionId::GenerateRandom();
+
+  RequestStatus(committed_id);
+  sent_.back().Respond(TransactionStatus::COMMITTED, HybridTime(2000));
+  RequestStatus(pending_id);
+  sent_.back().Respond(TransactionStatus::PENDING);
+  ASSERT_EQ(sent_.size(), 2);
+
+  // Final status is served from cache.
+  auto r = RequestStatus(committed_id);
+  ASSERT_EQ(sent_.size(), 2);
+  ASSERT_NO_FATALS(CheckReceived(r, TransactionStatus::COMMITTED));
+  ASSERT_EQ(received_[r]->response.status_hybrid_time(0), HybridTime(2000).ToUint64());
+
+  // Pending status is not cached.
+  RequestStatus(pending_id);
+  ASSERT_EQ(sent_.size(), 3);
+  sent_.back().Respond(TransactionStatus::ABORTED);
+
+  // Cache is not used when disabled.
+  FLAGS_transaction_status_cache_ttl_ms = 0;
+  auto aborted_id = TransactionId::GenerateRandom();
+  RequestStatus(aborted_id);
+  sent_.back().Respond(TransactionStatus::ABORTED);
+  ASSERT_EQ(sent_.size(), 4);
+  RequestStatus(aborted_id);
+  ASSERT_EQ(sent_.size(), 5);
+  sent_.back().Respond(TransactionStatus::ABORTED);
+}
+
+TEST_F(TransactionStatusBatcherTest, Abort) {
+  FLAGS_max_concurrent_transaction_status_requests_per_tablet = 1;
+  int owner1 = 0;
+  int owner2 = 0;
+  auto id1 = TransactionId::GenerateRandom();
+  auto id2 = TransactionId::GenerateRandom();
+
+  auto in_flight1 = RequestStatus(id1, &owner1);
+  auto in_flight2 = RequestStatus(id1, &owner2, kOtherStatusTablet);
+  auto pending1 = RequestStatus(id2, &owner1);
+  auto pending2 = RequestStatus(id1, &owner2);
+  ASSERT_EQ(sent_.size(), 2);
+
+  // All requests of the owner are aborted, both in flight and pending.
+  batcher_->Abort(&owner1);
+  for (auto idx : {in_flight1, pending1}) {
+    ASSERT_TRUE(received_[idx]);
+    ASSERT_TRUE(received_[idx]->status.IsAborted()) << received_[idx]->status;
+  }
+  ASSERT_FALSE(received_[in_flight2]);
+  ASSERT_FALSE(received_[pending2]);
+
+  // Response to batch with aborted requests is delivered to requests of other owners only.
+  sent_[0].Respond(TransactionStatus::PENDING);
+  ASSERT_FALSE(received_[pending2]);
+  ASSERT_EQ(sent_.size(), 3);
+  ASSERT_EQ(sent_[2].TransactionIds(), std::vector<TransactionId>{id1});
+  sent_[2].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(pending2, TransactionStatus::PENDING));
+
+  sent_[1].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(in_flight2, TransactionStatus::PENDING));
+}
+
+TEST_F(TransactionStatusBatcherTest, Errors) {
+  FLAGS_max_concurrent_transaction_status_requests_per_tablet = 1;
+  auto id1 = TransactionId::GenerateRandom();
+  auto id2 = TransactionId::GenerateRandom();
+
+  RequestStatus(id1);
+  auto r1 = RequestStatus(id1);
+  auto r2 = RequestStatus(id2);
+  sent_[0].Respond(TransactionStatus::PENDING);
+  ASSERT_EQ(sent_.size(), 2);
+
+  // Failure of batch is delivered to all of its requests.
+  sent_[1].callback(
+      STATUS(TimedOut, "Timed out"), tserver::GetTransactionStatusResponsePB());
+  for (auto idx : {r1, r2}) {
+    ASSERT_TRUE(received_[idx]);
+    ASSERT_TRUE(received_[idx]->status.IsTimedOut()) << received_[idx]->status;
+  }
+
+  // Response that does not match the request is reported as failure of all requests.
+  auto r3 = RequestStatus(id1);
+  ASSERT_EQ(sent_.size(), 3);
+  auto r4 = RequestStatus(id1);
+  auto r5 = RequestStatus(id2);
+  sent_[2].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(r3, TransactionStatus::PENDING));
+  ASSERT_EQ(sent_.size(), 4);
+  tserver::GetTransactionStatusResponsePB response;
+  response.add_status(TransactionStatus::PENDING);
+  response.add_status_hybrid_time(HybridTime(1000).ToUint64());
+  sent_[3].callback(Status::OK(), response);
+  for (auto idx : {r4, r5}) {
+    ASSERT_TRUE(received_[idx]);
+    ASSERT_TRUE(received_[idx]->status.IsIllegalState()) << received_[idx]->status;
+  }
+
+  // Batcher continues to work after failures.
+  auto r6 = RequestStatus(id2);
+  ASSERT_EQ(sent_.size(), 5);
+  sent_[4].Respond(TransactionStatus::PENDING);
+  ASSERT_NO_FATALS(CheckReceived(r6, TransactionStatus::PENDING));
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,438 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/transaction_status_batcher.h"
+
+#include <condition_variable>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <boost/optional.hpp>
+#include <gflags/gflags.h>
+
+#include "yb/client/transaction_rpc.h"
+
+#include "yb/common/wire_protocol.h"
+
+#include "yb/rpc/rpc.h"
+
+#include "yb/server/clock.h"
+
+#include "yb/tserver/tserver_service.pb.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(transaction_status_cache_ttl_ms, 1000,
+             "For how long committed and aborted transaction statuses are kept in the tablet "
+             "server wide cache of transaction statuses. 0 to disable the cache.");
+TAG_FLAG(transaction_status_cache_ttl_ms, runtime);
+TAG_FLAG(transaction_status_cache_ttl_ms, advanced);
+
+DEFINE_int32(max_concurrent_transaction_status_requests_per_tablet, 4,
+             "Max number of transaction status batches that tablet server sends concurrently to "
+             "the same status tablet. Requests arriving while all of them are in flight are "
+             "coalesced into the next batch.");
+TAG_FLAG(max_concurrent_transaction_status_requests_per_tablet, runtime);
+TAG_FLAG(max_concurrent_transaction_status_requests_per_tablet, advanced);
+
+DECLARE_uint64(max_transactions_in_status_request);
+
+using namespace std::placeholders;
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Owner whose callback is being invoked by the current thread, used to detect Abort from it.
+thread_local const void* invoking_callback_owner = nullptr;
+
+} // namespace
+
+class TransactionStatusBatcher::Impl {
+ public:
+  Impl(const server::ClockPtr& clock, const std::shared_future<client::YBClient*>& client_future)
+      : clock_(clock), client_future_(client_future) {}
+
+  Impl(const server::ClockPtr& clock, TransactionStatusRequestSender sender)
+      : clock_(clock), sender_(std::move(sender)) {}
+
+  ~Impl() {
+    LOG_IF(DFATAL, !closing_.load(std::memory_order_acquire))
+        << "Destroy transaction status batcher without Shutdown";
+  }
+
+  void Shutdown() {
+    closing_.store(true, std::memory_order_release);
+    // Aborts all running RPCs, so their callbacks fail pending requests.
+    rpcs_.Shutdown();
+  }
+
+  void RequestStatus(
+      const void* owner, const TabletId& status_tablet, const TransactionId& transaction_id,
+      TransactionStatusBatcherCallback callback) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      auto cached = FindCachedUnlocked(transaction_id);
+      if (cached) {
+        lock.unlock();
+        tserver::GetTransactionStatusResponsePB response;
+        response.add_status(cached->status);
+        response.add_status_hybrid_time(cached->status_ht.ToUint64());
+        callback(Status::OK(), response);
+        return;
+      }
+      queues_[status_tablet].pending.push_back(
+          Waiter{owner, transaction_id, std::move(callback)});
+    }
+    Execute(status_tablet);
+  }
+
+  void Abort(const void* owner) {
+    DCHECK_NE(invoking_callback_owner, owner) << "Abort from callback of the same owner";
+    std::vector<Waiter> aborted;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      for (auto& tablet_and_queue : queues_) {
+        ExtractWaitersOfOwner(owner, &tablet_and_queue.second.pending, &aborted);
+        for (auto& batch : tablet_and_queue.second.in_flight) {
+          ExtractWaitersOfOwner(owner, &batch.waiters, &aborted);
+        }
+      }
+      running_callbacks_cond_.wait(lock, [this, owner] {
+        return running_callbacks_.count(owner) == 0;
+      });
+    }
+    static const tserver::GetTransactionStatusResponsePB kEmptyResponse;
+    const auto status = STATUS(Aborted, "Aborted because of shutdown");
+    for (const auto& waiter : aborted) {
+      waiter.callback(status, kEmptyResponse);
+    }
+  }
+
+ private:
+  struct Waiter {
+    const void* owner;
+    TransactionId transaction_id;
+    TransactionStatusBatcherCallback callback;
+  };
+
+  struct Batch {
+    tserver::GetTransactionStatusRequestPB request;
+    std::vector<Waiter> waiters;
+    rpc::Rpcs::Handle handle;
+  };
+
+  // List is used, so batch is not moved while its RPC is in flight.
+  using Batches = std::list<Batch>;
+
+  struct TabletQueue {
+    // Requests that will be sent in the next batch.
+    std::vector<Waiter> pending;
+    // Batches that are currently in flight, limited by
+    // FLAGS_max_concurrent_transaction_status_requests_per_tablet.
+    Batches in_flight;
+  };
+
+  // Response for each transaction id, in the same form as response to request with only this
+  // transaction id.
+  using ResponsesMap = std::unordered_map<
+      TransactionId, tserver::GetTransactionStatusResponsePB, TransactionIdHash>;
+
+  struct CachedStatus {
+    TransactionStatus status;
+    HybridTime status_ht;
+    CoarseTimePoint expiration;
+  };
+
+  static void ExtractWaitersOfOwner(
+      const void* owner, std::vector<Waiter>* waiters, std::vector<Waiter>* out) {
+    auto w = waiters->begin();
+    for (auto it = waiters->begin(); it != waiters->end(); ++it) {
+      if (it->owner == owner) {
+        out->push_back(std::move(*it));
+      } else {
+        if (w != it) {
+          *w = std::move(*it);
+        }
+        ++w;
+      }
+    }
+    waiters->erase(w, waiters->end());
+  }
+
+  // Sends pending requests of the tablet as a single batch, unless the tablet already has max
+  // allowed number of batches in flight. In this case pending requests are sent when one of them
+  // completes.
+  void Execute(const TabletId& status_tablet) {
+    Batches::iterator batch;
+    std::vector<Waiter> failed;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = queues_[status_tablet];
+      if (queue.pending.empty()) {
+        return;
+      }
+      if (closing_.load(std::memory_order_acquire)) {
+        failed.swap(queue.pending);
+        StartCallbacksUnlocked(failed);
+      } else {
+        auto max_batches = std::max(
+            FLAGS_max_concurrent_transaction_status_requests_per_tablet, 1);
+        if (queue.in_flight.size() >= static_cast<size_t>(max_batches)) {
+          return;
+        }
+        batch = PrepareBatchUnlocked(status_tablet, &queue);
+      }
+    }
+    if (!failed.empty()) {
+      InvokeCallbacks(failed, STATUS(Aborted, "Aborted because of shutdown"), {});
+      return;
+    }
+
+    // Only this thread accesses request until it is sent.
+    batch->request.set_propagated_hybrid_time(clock_->Now().ToUint64());
+
+    VLOG(4) << "Request statuses from " << status_tablet << ": "
+            << batch->request.ShortDebugString();
+
+    auto callback = std::bind(&Impl::StatusReceived, this, status_tablet, batch, _1, _2);
+    if (sender_) {
+      sender_(batch->request, callback);
+      return;
+    }
+    auto client = client_future_.get();
+    if (!client || !rpcs_.RegisterAndStart(
+        client::GetTransactionStatus(
+            TransactionRpcDeadline(),
+            nullptr /* tablet */,
+            client,
+            &batch->request,
+            callback),
+        &batch->handle)) {
+      callback(STATUS(Aborted, "Aborted because cannot start RPC"),
+               tserver::GetTransactionStatusResponsePB());
+    }
+  }
+
+  // Moves pending requests of the queue to a new in flight batch, filling its request with their
+  // transaction ids.
+  Batches::iterator PrepareBatchUnlocked(const TabletId& status_tablet, TabletQueue* queue) {
+    auto batch = queue->in_flight.emplace(queue->in_flight.end());
+    batch->request.set_tablet_id(status_tablet);
+    batch->handle = rpcs_.InvalidHandle();
+    // Requests for the same transaction are sent once, so limit number of distinct ids.
+    std::unordered_set<TransactionId, TransactionIdHash> ids;
+    auto max_ids = std::max<uint64_t>(FLAGS_max_transactions_in_status_request, 1);
+    size_t taken = 0;
+    for (auto& waiter : queue->pending) {
+      if (ids.insert(waiter.transaction_id).second) {
+        if (ids.size() > max_ids) {
+          break;
+        }
+        const auto& id = waiter.transaction_id;
+        batch->request.add_transaction_id()->assign(
+            pointer_cast<const char*>(id.data()), id.size());
+      }
+      batch->waiters.push_back(std::move(waiter));
+      ++taken;
+    }
+    queue->pending.erase(queue->pending.begin(), queue->pending.begin() + taken);
+    return batch;
+  }
+
+  void StatusReceived(
+      const TabletId& status_tablet, Batches::iterator batch,
+      Status status, const tserver::GetTransactionStatusResponsePB& response) {
+    VLOG(4) << "Received statuses from " << status_tablet << ": " << status << ", "
+            << response.ShortDebugString();
+
+    // Request of the batch is not modified while it is in flight, so could be accessed w/o lock.
+    const auto& req = batch->request;
+    if (status.ok() && response.has_error()) {
+      status = StatusFromPB(response.error().status());
+    }
+    if (status.ok() && (response.status().size() != req.transaction_id().size() ||
+                        response.status_hybrid_time().size() != req.transaction_id().size())) {
+      status = STATUS_FORMAT(
+          IllegalState, "Bad response size, expected $0 entries, but found: $1",
+          req.transaction_id().size(), response.ShortDebugString());
+    }
+
+    ResponsesMap responses;
+    if (status.ok()) {
+      for (int i = 0; i != req.transaction_id().size(); ++i) {
+        auto id = FullyDecodeTransactionId(req.transaction_id(i));
+        if (!id.ok()) {
+          LOG(DFATAL) << "Bad transaction id in request: " << id.status();
+          continue;
+        }
+        auto& single_response = responses[*id];
+        if (response.has_propagated_hybrid_time()) {
+          single_response.set_propagated_hybrid_time(response.propagated_hybrid_time());
+        }
+        single_response.add_status(response.status(i));
+        single_response.add_status_hybrid_time(response.status_hybrid_time(i));
+      }
+    }
+
+    std::vector<Waiter> waiters;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto& queue = queues_[status_tablet];
+      rpcs_.Unregister(&batch->handle);
+      waiters.swap(batch->waiters);
+      queue.in_flight.erase(batch);
+      StartCallbacksUnlocked(waiters);
+      for (const auto& id_and_response : responses) {
+        auto txn_status = id_and_response.second.status(0);
+        if (txn_status == TransactionStatus::COMMITTED ||
+            txn_status == TransactionStatus::ABORTED) {
+          AddToCacheUnlocked(
+              id_and_response.first, txn_status,
+              HybridTime(id_and_response.second.status_hybrid_time(0)));
+        }
+      }
+    }
+
+    // Send next batch before invoking callbacks, so they don't delay it.
+    Execute(status_tablet);
+
+    InvokeCallbacks(waiters, status, responses);
+  }
+
+  // Counts callbacks of waiters as running, so Abort would wait for them.
+  void StartCallbacksUnlocked(const std::vector<Waiter>& waiters) {
+    for (const auto& waiter : waiters) {
+      ++running_callbacks_[waiter.owner];
+    }
+  }
+
+  // Invokes callbacks of waiters, that were counted as running by StartCallbacksUnlocked.
+  void InvokeCallbacks(
+      const std::vector<Waiter>& waiters, const Status& status,
+      const ResponsesMap& responses) {
+    if (waiters.empty()) {
+      return;
+    }
+    static const tserver::GetTransactionStatusResponsePB kEmptyResponse;
+    // Callback could request other statuses, so callbacks of other owners could be nested.
+    auto prev_owner = invoking_callback_owner;
+    for (const auto& waiter : waiters) {
+      invoking_callback_owner = waiter.owner;
+      if (!status.ok()) {
+        waiter.callback(status, kEmptyResponse);
+        continue;
+      }
+      auto it = responses.find(waiter.transaction_id);
+      if (it != responses.end()) {
+        waiter.callback(Status::OK(), it->second);
+      } else {
+        waiter.callback(
+            STATUS_FORMAT(IllegalState, "No status for $0", waiter.transaction_id),
+            kEmptyResponse);
+      }
+    }
+    invoking_callback_owner = prev_owner;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (const auto& waiter : waiters) {
+        auto it = running_callbacks_.find(waiter.owner);
+        if (--it->second == 0) {
+          running_callbacks_.erase(it);
+        }
+      }
+    }
+    running_callbacks_cond_.notify_all();
+  }
+
+  boost::optional<CachedStatus> FindCachedUnlocked(const TransactionId& transaction_id) {
+    CleanupCacheUnlocked(CoarseMonoClock::now());
+    auto it = cache_.find(transaction_id);
+    if (it == cache_.end()) {
+      return boost::none;
+    }
+    return it->second;
+  }
+
+  void AddToCacheUnlocked(
+      const TransactionId& transaction_id, TransactionStatus status, HybridTime status_ht) {
+    auto ttl_ms = FLAGS_transaction_status_cache_ttl_ms;
+    if (ttl_ms <= 0) {
+      return;
+    }
+    auto now = CoarseMonoClock::now();
+    CleanupCacheUnlocked(now);
+    auto expiration = now + std::chrono::milliseconds(ttl_ms);
+    if (cache_.emplace(transaction_id, CachedStatus{status, status_ht, expiration}).second) {
+      cache_expiration_queue_.push_back({transaction_id, expiration});
+    }
+  }
+
+  void CleanupCacheUnlocked(CoarseTimePoint now) {
+    while (!cache_expiration_queue_.empty() && cache_expiration_queue_.front().second <= now) {
+      cache_.erase(cache_expiration_queue_.front().first);
+      cache_expiration_queue_.pop_front();
+    }
+  }
+
+  server::ClockPtr clock_;
+  std::shared_future<client::YBClient*> client_future_;
+  // When specified, used to send requests instead of RPC. Used in tests.
+  TransactionStatusRequestSender sender_;
+  rpc::Rpcs rpcs_;
+  std::atomic<bool> closing_{false};
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, TabletQueue> queues_;
+  // Number of callbacks of each owner, that are being invoked now.
+  std::unordered_map<const void*, size_t> running_callbacks_;
+  std::condition_variable running_callbacks_cond_;
+
+  std::unordered_map<TransactionId, CachedStatus, TransactionIdHash> cache_;
+  // Since all entries have the same TTL, this queue is ordered by expiration time.
+  std::deque<std::pair<TransactionId, CoarseTimePoint>> cache_expiration_queue_;
+};
+
+TransactionStatusBatcher::TransactionStatusBatcher(
+    const server::ClockPtr& clock, const std::shared_future<client::YBClient*>& client_future)
+    : impl_(new Impl(clock, client_future)) {
+}
+
+TransactionStatusBatcher::TransactionStatusBatcher(
+    const server::ClockPtr& clock, TransactionStatusRequestSender sender)
+    : impl_(new Impl(clock, std::move(sender))) {
+}
+
+TransactionStatusBatcher::~TransactionStatusBatcher() {}
+
+void TransactionStatusBatcher::Shutdown() {
+  impl_->Shutdown();
+}
+
+void TransactionStatusBatcher::RequestStatus(
+    const void* owner, const TabletId& status_tablet, const TransactionId& transaction_id,
+    TransactionStatusBatcherCallback callback) {
+  impl_->RequestStatus(owner, status_tablet, transaction_id, std::move(callback));
+}
+
+void TransactionStatusBatcher::Abort(const void* owner) {
+  impl_->Abort(owner);
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,92 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+#define YB_TABLET_TRANSACTION_STATUS_BATCHER_H
+
+#include <functional>
+#include <future>
+#include <memory>
+
+#include "yb/client/client_fwd.h"
+
+#include "yb/common/entity_ids.h"
+#include "yb/common/transaction.h"
+
+#include "yb/server/server_fwd.h"
+
+#include "yb/util/status.h"
+
+namespace yb {
+
+namespace tserver {
+
+class GetTransactionStatusRequestPB;
+class GetTransactionStatusResponsePB;
+
+}
+
+namespace tablet {
+
+using TransactionStatusBatcherCallback =
+    std::function<void(const Status&, const tserver::GetTransactionStatusResponsePB&)>;
+
+// Sends request to status tablet and invokes callback with the response.
+using TransactionStatusRequestSender = std::function<void(
+    const tserver::GetTransactionStatusRequestPB&, TransactionStatusBatcherCallback)>;
+
+// Tablet server wide service to request transaction statuses from status tablets.
+//
+// Participants of all tablets on the tablet server request statuses through this class, so
+// requests to the same status tablet are coalesced: while max allowed number of requests to a
+// status tablet are in flight, new requests are queued and then sent as a single batch, with each
+// transaction id requested only once. Since the batch is sent after all of its requests were
+// added, its response is as fresh as a separate response to each of them would be.
+//
+// Committed and aborted statuses are final, so they are kept in a short-lived cache shared by all
+// participants, and are returned without sending any RPC.
+//
+// Each batch carries propagated hybrid time, taken from clock when the batch is sent.
+class TransactionStatusBatcher {
+ public:
+  TransactionStatusBatcher(
+      const server::ClockPtr& clock, const std::shared_future<client::YBClient*>& client_future);
+  // Sends requests using specified sender instead of RPC, used in tests.
+  TransactionStatusBatcher(const server::ClockPtr& clock, TransactionStatusRequestSender sender);
+  ~TransactionStatusBatcher();
+
+  void Shutdown();
+
+  // Requests status of transaction from its status tablet. Callback is invoked with the response
+  // containing status of exactly this transaction, or with failure status.
+  // owner identifies requester, so its pending requests could be aborted by Abort.
+  void RequestStatus(
+      const void* owner, const TabletId& status_tablet, const TransactionId& transaction_id,
+      TransactionStatusBatcherCallback callback);
+
+  // Invokes callbacks of all pending requests of specified owner with Aborted status and waits
+  // until callbacks of this owner that are already running complete. So no callback of this owner
+  // would be invoked after this call.
+  // Should not be invoked from callback of the same owner, since it would wait for itself.
+  void Abort(const void* owner);
+
+ private:
+  class Impl;
+
+  std::unique_ptr<Impl> impl_;
+};
+
+} // namespace tablet
+} // namespace yb
+
+#endif // YB_TABLET_TRANSACTION_STATUS_BATCHER_H
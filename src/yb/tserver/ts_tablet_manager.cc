@@ -80,6 +80,7 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/tablet_options.h"
+#include "yb/tablet/transaction_status_batcher.h"
 #include "yb/tablet/operations/split_operation.h"
 
 #include "yb/tserver/heartbeater.h"
@@ -126,6 +127,22 @@ DEFINE_int32(db_block_cache_num_shard_bits, 4,
              "Number of bits to use for sharding the block cache (defaults to 4 bits)");
 TAG_FLAG(db_block_cache_num_shard_bits, advanced);
 
+DEFINE_string(db_block_cache_type, "lru",
+              "Replacement policy of the block cache, and of the compressed block cache when it is "
+              "enabled: lru, or clock for CLOCK replacement with frequency based admission, that "
+              "does not take exclusive lock on cache hits.");
+TAG_FLAG(db_block_cache_type, advanced);
+
+static bool ValidateDbBlockCacheType(const char* flagname, const std::string& value) {
+  if (value == "lru" || value == "clock") {
+    return true;
+  }
+  LOG(ERROR) << "Expect " << flagname << " to be lru or clock, got: " << value;
+  return false;
+}
+__attribute__((unused))
+DEFINE_validator(db_block_cache_type, &ValidateDbBlockCacheType);
+
 DEFINE_bool(enable_log_cache_gc, true,
             "Set to true to enable log cache garbage collector.");
 
@@ -209,6 +226,12 @@ DEFINE_int32(db_block_cache_size_percentage, 50,
              "Default percentage of total available memory to use as block cache size, if not "
              "asking for a raw number, through FLAGS_db_block_cache_size_bytes.");
 
+DEFINE_int32(db_block_cache_compressed_percentage, 0,
+             "Percentage of the block cache size to use for the secondary cache of compressed "
+             "blocks. Blocks missing in the cache of uncompressed blocks are decompressed from "
+             "it instead of being read from disk. 0 disables the compressed block cache.");
+TAG_FLAG(db_block_cache_compressed_percentage, advanced);
+
 DEFINE_int32(read_pool_max_threads, 128,
              "The maximum number of threads allowed for read_pool_. This pool is used "
              "to run multiple read operations, that are part of the same tablet rpc, "
@@ -218,6 +241,27 @@ DEFINE_int32(read_pool_max_queue_size, 128,
              "is used to run multiple read operations, that are part of the same tablet rpc, "
              "in parallel.");
 
+DEFINE_int32(memtable_insert_pool_max_threads, 0,
+             "The maximum number of threads used to insert a single large write batch into the "
+             "regular RocksDB memtable in parallel with the applying thread. 0 disables parallel "
+             "memtable inserts.");
+TAG_FLAG(memtable_insert_pool_max_threads, advanced);
+
+DEFINE_int32(data_block_prefetch_pool_max_threads, 0,
+             "The maximum number of threads used to load data blocks into the block cache ahead of "
+             "sequential scans. 0 disables data block prefetching.");
+TAG_FLAG(data_block_prefetch_pool_max_threads, advanced);
+
+DEFINE_int32(apply_intents_pool_max_threads, 0,
+             "The maximum number of threads used to look up intents of a single large transaction "
+             "in parallel while applying it. 0 disables parallel apply.");
+TAG_FLAG(apply_intents_pool_max_threads, advanced);
+
+DEFINE_int32(parallel_scan_pool_max_threads, 0,
+             "The maximum number of threads used to scan key ranges of a tablet in parallel for "
+             "a single YSQL aggregate read. 0 disables parallel scans.");
+TAG_FLAG(parallel_scan_pool_max_threads, advanced);
+
 DEFINE_test_flag(int32, sleep_after_tombstoning_tablet_secs, 0,
                  "Whether we sleep in LogAndTombstone after calling DeleteTabletData.");
 
@@ -366,27 +410,45 @@ TabletPeerPtr TSTabletManager::TabletToFlush() {
 
 namespace {
 
+// Evicts from the block caches in the specified order, until required amount of memory is
+// released.
 class LRUCacheGC : public GarbageCollector {
  public:
-  explicit LRUCacheGC(std::shared_ptr<rocksdb::Cache> cache) : cache_(std::move(cache)) {}
+  explicit LRUCacheGC(std::vector<std::shared_ptr<rocksdb::Cache>> caches)
+      : caches_(std::move(caches)) {}
 
   void CollectGarbage(size_t required) {
     if (!FLAGS_enable_block_based_table_cache_gc) {
       return;
     }
 
-    auto evicted = cache_->Evict(required);
+    size_t evicted = 0;
+    size_t usage = 0;
+    for (const auto& cache : caches_) {
+      if (evicted < required) {
+        evicted += cache->Evict(required - evicted);
+      }
+      usage += cache->GetUsage();
+    }
     LOG(INFO) << "Evicted from table cache: " << HumanReadableNumBytes::ToString(evicted)
-              << ", new usage: " << HumanReadableNumBytes::ToString(cache_->GetUsage())
+              << ", new usage: " << HumanReadableNumBytes::ToString(usage)
               << ", required: " << HumanReadableNumBytes::ToString(required);
   }
 
   virtual ~LRUCacheGC() = default;
 
  private:
-  std::shared_ptr<rocksdb::Cache> cache_;
+  std::vector<std::shared_ptr<rocksdb::Cache>> caches_;
 };
 
+// Creates block cache of the type specified by --db_block_cache_type.
+std::shared_ptr<rocksdb::Cache> NewBlockCache(size_t capacity) {
+  if (FLAGS_db_block_cache_type == "clock") {
+    return rocksdb::NewClockCache(capacity, FLAGS_db_block_cache_num_shard_bits);
+  }
+  return rocksdb::NewLRUCache(capacity, FLAGS_db_block_cache_num_shard_bits);
+}
+
 class FunctorGC : public GarbageCollector {
  public:
   explicit FunctorGC(std::function<void(size_t)> impl) : impl_(std::move(impl)) {}
@@ -453,6 +515,30 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
                .set_max_queue_size(FLAGS_read_pool_max_queue_size)
                .set_metrics(std::move(read_metrics))
                .Build(&read_pool_));
+  if (FLAGS_memtable_insert_pool_max_threads > 0) {
+    CHECK_OK(ThreadPoolBuilder("memtable-insert")
+                 .set_max_threads(FLAGS_memtable_insert_pool_max_threads)
+                 .Build(&memtable_insert_pool_));
+    tablet_options_.memtable_insert_pool = memtable_insert_pool_.get();
+  }
+  if (FLAGS_data_block_prefetch_pool_max_threads > 0) {
+    CHECK_OK(ThreadPoolBuilder("block-prefetch")
+                 .set_max_threads(FLAGS_data_block_prefetch_pool_max_threads)
+                 .Build(&data_block_prefetch_pool_));
+    tablet_options_.data_block_prefetch_pool = data_block_prefetch_pool_.get();
+  }
+  if (FLAGS_apply_intents_pool_max_threads > 0) {
+    CHECK_OK(ThreadPoolBuilder("apply-intents")
+                 .set_max_threads(FLAGS_apply_intents_pool_max_threads)
+                 .Build(&apply_intents_pool_));
+    tablet_options_.apply_intents_pool = apply_intents_pool_.get();
+  }
+  if (FLAGS_parallel_scan_pool_max_threads > 0) {
+    CHECK_OK(ThreadPoolBuilder("parallel-scan")
+                 .set_max_threads(FLAGS_parallel_scan_pool_max_threads)
+                 .Build(&parallel_scan_pool_));
+    tablet_options_.parallel_scan_pool = parallel_scan_pool_.get();
+  }
 
   int64_t block_cache_size_bytes = FLAGS_db_block_cache_size_bytes;
   int64_t total_ram_avail = MemTracker::GetRootTracker()->limit();
@@ -472,10 +558,24 @@ TSTabletManager::TSTabletManager(FsManager* fs_manager,
       block_cache_size_bytes, "BlockBasedTable", server_->mem_tracker());
 
   if (FLAGS_db_block_cache_size_bytes != kDbCacheSizeCacheDisabled) {
-    tablet_options_.block_cache = rocksdb::NewLRUCache(block_cache_size_bytes,
-                                                       FLAGS_db_block_cache_num_shard_bits);
+    CHECK(FLAGS_db_block_cache_compressed_percentage >= 0 &&
+          FLAGS_db_block_cache_compressed_percentage < 100)
+        << "Flag db_block_cache_compressed_percentage must be between 0 and 99. Current value: "
+        << FLAGS_db_block_cache_compressed_percentage;
+    // Compressed blocks tier is carved out of the block cache memory, so the total stays the same.
+    int64_t compressed_size_bytes =
+        block_cache_size_bytes * FLAGS_db_block_cache_compressed_percentage / 100;
+    block_cache_size_bytes -= compressed_size_bytes;
+    tablet_options_.block_cache = NewBlockCache(block_cache_size_bytes);
     tablet_options_.block_cache->SetMetrics(server_->metric_entity());
-    block_based_table_gc_ = std::make_shared<LRUCacheGC>(tablet_options_.block_cache);
+    // Uncompressed blocks are evicted first, since they could be restored from the compressed
+    // tier without IO.
+    std::vector<std::shared_ptr<rocksdb::Cache>> caches = {tablet_options_.block_cache};
+    if (compressed_size_bytes > 0) {
+      tablet_options_.block_cache_compressed = NewBlockCache(compressed_size_bytes);
+      caches.push_back(tablet_options_.block_cache_compressed);
+    }
+    block_based_table_gc_ = std::make_shared<LRUCacheGC>(std::move(caches));
     block_based_table_mem_tracker_->AddGarbageCollector(block_based_table_gc_);
   }
 
@@ -524,6 +624,9 @@ Status TSTabletManager::Init() {
       &server_->options(), server_->metric_entity(), server_->mem_tracker(),
       server_->messenger());
 
+  transaction_status_batcher_ = std::make_unique<tablet::TransactionStatusBatcher>(
+      scoped_refptr<server::Clock>(server_->clock()), async_client_init_->get_client_future());
+
   async_client_init_->AddPostCreateHook([this](client::YBClient* client) {
     auto* tserver = server();
     if (tserver != nullptr && tserver->proxy() != nullptr) {
@@ -1233,7 +1336,8 @@ Result<TabletPeerPtr> TSTabletManager::CreateAndRegisterTabletPeer(
       Bind(&TSTabletManager::ApplyChange, Unretained(this), meta->raft_group_id()),
       metric_registry_,
       this,
-      async_client_init_->get_client_future()));
+      async_client_init_->get_client_future(),
+      transaction_status_batcher_.get()));
   RETURN_NOT_OK(RegisterTablet(meta->raft_group_id(), tablet_peer, mode));
   return tablet_peer;
 }
@@ -1543,6 +1647,10 @@ void TSTabletManager::StartShutdown() {
 
   async_client_init_->Shutdown();
 
+  if (transaction_status_batcher_) {
+    transaction_status_batcher_->Shutdown();
+  }
+
   if (background_task_) {
     background_task_->Shutdown();
   }
@@ -1600,6 +1708,18 @@ void TSTabletManager::CompleteShutdown() {
   if (append_pool_) {
     append_pool_->Shutdown();
   }
+  if (memtable_insert_pool_) {
+    memtable_insert_pool_->Shutdown();
+  }
+  if (data_block_prefetch_pool_) {
+    data_block_prefetch_pool_->Shutdown();
+  }
+  if (apply_intents_pool_) {
+    apply_intents_pool_->Shutdown();
+  }
+  if (parallel_scan_pool_) {
+    parallel_scan_pool_->Shutdown();
+  }
 
   {
     std::lock_guard<RWMutex> l(mutex_);
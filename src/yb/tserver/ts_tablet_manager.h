@@ -561,6 +561,22 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
   // Thread pool for read ops, that are run in parallel, shared between all tablets.
   std::unique_ptr<ThreadPool> read_pool_;
 
+  // Thread pool used to insert large write batches into memtables in parallel, shared between all
+  // tablets. Null when parallel memtable inserts are disabled.
+  std::unique_ptr<ThreadPool> memtable_insert_pool_;
+
+  // Thread pool used to prefetch data blocks of sequential scans, shared between all tablets.
+  // Null when prefetching is disabled.
+  std::unique_ptr<ThreadPool> data_block_prefetch_pool_;
+
+  // Thread pool used to look up intents of large transactions in parallel during apply, shared
+  // between all tablets. Null when parallel apply is disabled.
+  std::unique_ptr<ThreadPool> apply_intents_pool_;
+
+  // Thread pool used to scan key ranges of tablets in parallel for YSQL aggregates, shared between
+  // all tablets. Null when parallel scans are disabled.
+  std::unique_ptr<ThreadPool> parallel_scan_pool_;
+
   std::unique_ptr<rpc::Poller> tablets_cleaner_;
 
   // Used for scheduling flushes
@@ -571,6 +587,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   boost::optional<yb::client::AsyncClientInitialiser> async_client_init_;
 
+  // Tablet server wide service for transaction status requests of all tablet participants.
+  std::unique_ptr<tablet::TransactionStatusBatcher> transaction_status_batcher_;
+
   TabletPeers shutting_down_peers_;
 
   std::shared_ptr<GarbageCollector> block_based_table_gc_;
@@ -37,6 +37,9 @@ struct FileSystemOptions {
 
   // If true, then use mmap to read data.
   bool use_mmap_reads = false;
+
+  // If true, then read data with O_DIRECT, bypassing OS buffers. Ignored when mmap reads are used.
+  bool use_direct_reads = false;
 };
 
 // Interface to filesystem.
@@ -13,9 +13,12 @@
 
 #include "yb/util/file_system_posix.h"
 
+#include <algorithm>
+
 #include <errno.h>
 #include <fcntl.h>
 #include <stdio.h>
+#include <string.h>
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -28,6 +31,7 @@
 #include <sys/syscall.h>
 #endif // __linux__
 
+#include "yb/util/alignment.h"
 #include "yb/util/coding.h"
 #include "yb/util/debug/trace_event.h"
 #include "yb/util/errno.h"
@@ -35,6 +39,7 @@
 #include "yb/util/thread_restrictions.h"
 
 DECLARE_bool(suicide_on_eio);
+DECLARE_int32(o_direct_block_alignment_bytes);
 
 // For platforms without fdatasync (like OS X)
 #ifndef fdatasync
@@ -265,4 +270,61 @@ Status PosixRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
 #endif
 }
 
+PosixDirectRandomAccessFile::PosixDirectRandomAccessFile(
+    const std::string& fname, int fd, const FileSystemOptions& options)
+    : PosixRandomAccessFile(fname, fd, options),
+      alignment_(FLAGS_o_direct_block_alignment_bytes) {
+}
+
+Status PosixDirectRandomAccessFile::Read(uint64_t offset, size_t n, Slice* result,
+                                         uint8_t* scratch) const {
+  ThreadRestrictions::AssertIOAllowed();
+  const uint64_t aligned_offset = YB_ALIGN_DOWN(offset, alignment_);
+  const size_t prefix = offset - aligned_offset;
+  const size_t aligned_size = align_up(prefix + n, alignment_);
+
+  // Read directly to scratch when request is already aligned, otherwise use a temporary buffer.
+  std::unique_ptr<uint8_t, decltype(&free)> buffer(nullptr, &free);
+  uint8_t* dest = scratch;
+  if (prefix != 0 || aligned_size != n || align_up(scratch, alignment_) != scratch) {
+    void* temp_buf = nullptr;
+    auto err = posix_memalign(&temp_buf, alignment_, aligned_size);
+    if (err) {
+      *result = Slice(scratch, static_cast<size_t>(0));
+      return STATUS(RuntimeError, "Unable to allocate memory", Errno(err));
+    }
+    buffer.reset(static_cast<uint8_t*>(temp_buf));
+    dest = buffer.get();
+  }
+
+  size_t read = 0;
+  while (read < aligned_size) {
+    ssize_t r = pread(fd_, dest + read, aligned_size - read,
+                      static_cast<off_t>(aligned_offset + read));
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      *result = Slice(scratch, static_cast<size_t>(0));
+      return STATUS_IO_ERROR(filename_, errno);
+    }
+    read += r;
+    // Unaligned read means that we reached the end of file.
+    if (r == 0 || r % alignment_ != 0) {
+      break;
+    }
+  }
+
+  size_t size = read > prefix ? std::min(read - prefix, n) : 0;
+  if (dest != scratch) {
+    memcpy(scratch, dest + prefix, size);
+  }
+  *result = Slice(scratch, size);
+  return Status::OK();
+}
+
+Status PosixDirectRandomAccessFile::InvalidateCache(size_t offset, size_t length) {
+  return Status::OK();
+}
+
 } // namespace yb
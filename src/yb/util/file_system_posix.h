@@ -64,12 +64,31 @@ class PosixRandomAccessFile : public RandomAccessFile {
   virtual void Hint(AccessPattern pattern) override;
   virtual CHECKED_STATUS InvalidateCache(size_t offset, size_t length) override;
 
- private:
+ protected:
   std::string filename_;
   int fd_;
   bool use_os_buffer_;
 };
 
+// pread() based random-access file for a file descriptor opened with O_DIRECT.
+// Reads are expanded to o_direct_block_alignment_bytes boundaries and performed into an aligned
+// buffer, so blocks that are already cached by the caller do not occupy OS page cache.
+class PosixDirectRandomAccessFile : public PosixRandomAccessFile {
+ public:
+  PosixDirectRandomAccessFile(const std::string& fname, int fd,
+                              const FileSystemOptions& options);
+
+  CHECKED_STATUS Read(uint64_t offset, size_t n, Slice* result,
+                      uint8_t* scratch) const override;
+
+  // Page cache is not used, so there is nothing to advise or invalidate.
+  void Hint(AccessPattern pattern) override {}
+  CHECKED_STATUS InvalidateCache(size_t offset, size_t length) override;
+
+ private:
+  const size_t alignment_;
+};
+
 } // namespace yb
 
 #endif  // YB_UTIL_FILE_SYSTEM_POSIX_H